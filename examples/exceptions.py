@@ -0,0 +1,77 @@
+# *****************************************************************************
+#
+#   Licensed under the Apache License, Version 2.0 (the "License");
+#   you may not use this file except in compliance with the License.
+#   You may obtain a copy of the License at
+#
+#       http://www.apache.org/licenses/LICENSE-2.0
+#
+#   Unless required by applicable law or agreed to in writing, software
+#   distributed under the License is distributed on an "AS IS" BASIS,
+#   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#   See the License for the specific language governing permissions and
+#   limitations under the License.
+#
+#   See NOTICE file for details.
+#
+# *****************************************************************************
+"""Measure the cost of Java exceptions which are caught in Python.
+
+Each loop calls a Java method which throws and catches the exception in
+Python.  The first loop discards the exception so the message is never
+fetched.  The second reads the message and the third formats the traceback
+with the Java frames and causes.
+
+    python exceptions.py [--count N] [--classpath PATH]
+"""
+import argparse
+import time
+import traceback
+
+import jpype
+
+
+def discard(parse, count):
+    for i in range(count):
+        try:
+            parse("x")
+        except ValueError:
+            pass
+
+
+def message(parse, count):
+    for i in range(count):
+        try:
+            parse("x")
+        except ValueError as ex:
+            ex.args
+
+
+def formatted(parse, count):
+    for i in range(count):
+        try:
+            parse("x")
+        except ValueError as ex:
+            traceback.format_exception(type(ex), ex, ex.__traceback__)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--count", type=int, default=100000)
+    parser.add_argument("--classpath", default=None)
+    args = parser.parse_args()
+
+    jpype.startJVM(classpath=args.classpath, convertStrings=False)
+    parse = jpype.JClass("java.lang.Integer").parseInt
+    # Warm up the method dispatch and the exception class cache
+    discard(parse, 1000)
+    for name, func in (("discard", discard), ("message", message), ("formatted", formatted)):
+        start = time.perf_counter()
+        func(parse, args.count)
+        elapsed = time.perf_counter() - start
+        print("%-10s %.2fus per exception" % (name, elapsed * 1e6 / args.count))
+
+
+if __name__ == "__main__":
+    main()
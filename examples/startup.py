@@ -0,0 +1,82 @@
+# *****************************************************************************
+#
+#   Licensed under the Apache License, Version 2.0 (the "License");
+#   you may not use this file except in compliance with the License.
+#   You may obtain a copy of the License at
+#
+#       http://www.apache.org/licenses/LICENSE-2.0
+#
+#   Unless required by applicable law or agreed to in writing, software
+#   distributed under the License is distributed on an "AS IS" BASIS,
+#   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#   See the License for the specific language governing permissions and
+#   limitations under the License.
+#
+#   See NOTICE file for details.
+#
+# *****************************************************************************
+"""Measure the start up time of JPype with the start up caches.
+
+Each configuration is run in a fresh process a number of times and the
+median time to start the JVM and load a set of classes is reported.  The
+first run of a configuration creates its cache files and is not counted.
+
+    python startup.py [--runs N] [--classpath PATH] [class ...]
+"""
+import argparse
+import os
+import statistics
+import subprocess
+import sys
+import tempfile
+
+SCRIPT = """
+import time
+start = time.perf_counter()
+import jpype
+jpype.startJVM(classpath=%(classpath)r, **%(options)r)
+for name in %(classes)r:
+    cls = jpype.JClass(name)
+    for attr in dir(cls):
+        getattr(cls, attr, None)
+print(time.perf_counter() - start)
+"""
+
+
+def run(classpath, options, classes):
+    script = SCRIPT % dict(classpath=classpath, options=options, classes=classes)
+    out = subprocess.check_output([sys.executable, "-c", script])
+    return float(out.decode().split()[-1])
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--runs", type=int, default=5)
+    parser.add_argument("--classpath", default=None)
+    parser.add_argument("classes", nargs="*", default=[
+        "java.util.ArrayList", "java.util.HashMap", "java.util.concurrent.ConcurrentHashMap",
+        "java.lang.StringBuilder", "java.nio.ByteBuffer", "java.time.LocalDateTime"])
+    args = parser.parse_args()
+
+    with tempfile.TemporaryDirectory() as cache:
+        configs = [
+            ("default", {}),
+            ("classSnapshot", {"classSnapshot": os.path.join(cache, "types.snapshot")}),
+            ("packageIndex", {"packageIndex": os.path.join(cache, "jpype.index")}),
+            ("classDataArchive", {"classDataArchive": os.path.join(cache, "jpype.jsa")}),
+        ]
+        configs.append(("all", dict(i for _, c in configs for i in c.items())))
+        for name, options in configs:
+            try:
+                # Create the cache files
+                run(args.classpath, options, args.classes)
+                times = [run(args.classpath, options, args.classes) for i in range(args.runs)]
+            except subprocess.CalledProcessError:
+                print("%-18s failed" % name)
+                continue
+            print("%-18s median %.3fs  min %.3fs" % (name, statistics.median(times), min(times)))
+
+
+if __name__ == "__main__":
+    main()
@@ -39,6 +39,7 @@ from . import _jcollection  # lgtm [py/import-own-module]
 from . import _jio          # lgtm [py/import-own-module]
 from . import protocol      # lgtm [py/import-own-module]
 from . import _jthread      # lgtm [py/import-own-module]
+from . import _jconcurrent  # lgtm [py/import-own-module]
 
 __all__ = ['java', 'javax']
 __all__.extend(_jinit.__all__)
@@ -59,8 +59,7 @@ def addClassPath(path1):
             paths = list(path1.parent.glob("*.jar"))
             if len(paths) == 0:
                 return
-            for path in paths:
-                classLoader.addFile(Paths.get(str(path)))
+            classLoader.addFiles([Paths.get(str(path)) for path in paths])
         else:
             classLoader.addFile(Paths.get(str(path1)))
     _CLASSPATHS.append(path1)
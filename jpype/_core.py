@@ -15,6 +15,7 @@
 #   See NOTICE file for details.
 #
 # *****************************************************************************
+import os
 import sys
 import atexit
 import _jpype
@@ -35,7 +36,7 @@ from importlib import util as _util
 __all__ = [
     'isJVMStarted', 'startJVM', 'shutdownJVM',
     'getDefaultJVMPath', 'getJVMVersion', 'isThreadAttachedToJVM', 'attachThreadToJVM',
-    'detachThreadFromJVM', 'synchronized',
+    'detachThreadFromJVM', 'synchronized', 'setGILPolicy', 'preload',
     'JVMNotFoundException', 'JVMNotSupportedException', 'JVMNotRunning'
 ]
 
@@ -119,6 +120,40 @@ def _handleClassPath(clsList):
     return _classpath._SEP.join(out)
 
 
+def _javaVersion(jvmpath):
+    """ Get the major version of the JVM from the release file of its home.
+
+    Returns None if the version can not be determined.
+    """
+    home = os.path.dirname(os.path.abspath(jvmpath))
+    for i in range(4):
+        release = os.path.join(home, 'release')
+        if os.path.isfile(release):
+            with open(release) as fd:
+                for line in fd:
+                    if line.startswith('JAVA_VERSION='):
+                        version = line.split('=', 1)[1].strip().strip('"')
+                        parts = version.split('.')
+                        try:
+                            if parts[0] == '1' and len(parts) > 1:
+                                return int(parts[1])
+                            return int(parts[0].split('-')[0].split('+')[0])
+                        except ValueError:
+                            return None
+            return None
+        home = os.path.dirname(home)
+    return None
+
+
+def _classDataArgs(archive):
+    """ Get the JVM arguments to use or create a class data archive. """
+    archive = os.path.abspath(archive)
+    if os.path.exists(archive):
+        # The JVM silently falls back if the archive does not match
+        return ['-XX:SharedArchiveFile=%s' % archive, '-Xshare:auto']
+    return ['-XX:ArchiveClassesAtExit=%s' % archive]
+
+
 _JVM_started = False
 
 
@@ -158,6 +193,17 @@ def startJVM(*args, **kwargs):
         transfer control to Python rather than halting.  If
         not specified will be False if Python is started as
         an interactive shell.
+      classSnapshot (str): File to hold the resolved overloads of
+        each class between runs.  The file is written when the JVM
+        is shutdown and is ignored if the JVM or classpath changes.
+      classDataArchive (str): File holding a class data sharing archive
+        for the JVM.  If the file does not exist, it is created with
+        the classes loaded by this run when the JVM is shutdown.
+        Requires Java 13 or later; a RuntimeError is raised for older
+        JVMs.
+      packageIndex (str): File to hold the listing of each jar on the
+        classpath between runs so that imports do not need to search
+        the jars.  Jars are listed again if they change.
 
     Raises:
       OSError: if the JVM cannot be started or is already running.
@@ -200,6 +246,22 @@ def startJVM(*args, **kwargs):
         # Not speficied at all, use the default classpath
         classpath = _classpath.getClassPath()
 
+    # Class data sharing can only archive the support classes if they are
+    # on the system classpath.
+    classDataArchive = kwargs.pop('classDataArchive', None)
+    if classDataArchive:
+        version = _javaVersion(jvmpath)
+        if version is not None and version < 13:
+            raise RuntimeError("classDataArchive requires Java 13 or later, "
+                               "%s is Java %d" % (jvmpath, version))
+        args.extend(_classDataArgs(classDataArchive))
+        if not _hasClassPath(args):
+            if isinstance(classpath, str):
+                classpath = [classpath]
+            classpath = list(classpath or [])
+            classpath.append(os.path.join(
+                os.path.dirname(_jpype.__file__), 'org.jpype.jar'))
+
     # Handle strings and list of strings.
     if classpath:
         if isinstance(classpath, str):
@@ -209,6 +271,16 @@ def startJVM(*args, **kwargs):
         else:
             raise TypeError("Unknown class path element")
 
+    classSnapshot = kwargs.pop('classSnapshot', None)
+    if classSnapshot:
+        args.append('-Dorg.jpype.manager.snapshot=%s' %
+                    os.path.abspath(classSnapshot))
+
+    packageIndex = kwargs.pop('packageIndex', None)
+    if packageIndex:
+        args.append('-Dorg.jpype.pkg.index=%s' %
+                    os.path.abspath(packageIndex))
+
     ignoreUnrecognized = kwargs.pop('ignoreUnrecognized', False)
     convertStrings = kwargs.pop('convertStrings', False)
     interrupt = kwargs.pop('interrupt', not interactive())
@@ -230,6 +302,9 @@ def startJVM(*args, **kwargs):
                 version = int(match.group(1)) - 44
                 raise RuntimeError("%s is older than required Java version %d" % (
                     jvmpath, version)) from ex
+        if classDataArchive:
+            raise RuntimeError("Unable to start %s with classDataArchive, "
+                               "which requires Java 13 or later" % jvmpath) from ex
         raise
 
 
@@ -413,6 +488,87 @@ def synchronized(obj):
     return _jpype._JMonitor(obj)
 
 
+_GIL_POLICIES = {'always': 0, 'never': 1, 'adaptive': 2}
+
+
+def setGILPolicy(target, policy):
+    """ Set when the GIL is released while calling Java methods.
+
+    By default the GIL is released for every call to Java so that other
+    Python threads may run while Java is working.  For trivial methods
+    such as getters the cost of releasing and reacquiring the GIL can
+    exceed the cost of the call itself.
+
+    Policies:
+      - ``"always"``: release the GIL for every call (default).
+      - ``"never"``: hold the GIL.  Only use this for methods which
+        never block or call back into Python from another thread.
+      - ``"adaptive"``: measure the first calls and hold the GIL if they
+        are trivial.  If a call later takes long the GIL is released for
+        all further calls.
+
+    Arguments:
+        target: A Java method, or a Java class to apply the policy to all of
+          its methods and constructors.
+        policy (str): One of "always", "never", or "adaptive".
+
+    Example:
+
+    .. code-block:: python
+
+      setGILPolicy(java.awt.Point.getX, "never")
+      setGILPolicy(java.util.ArrayList, "adaptive")
+
+    """
+    try:
+        code = _GIL_POLICIES[policy]
+    except KeyError:
+        raise ValueError("GIL policy must be one of %s" %
+                         ", ".join(_GIL_POLICIES)) from None
+    if isinstance(target, (_jpype._JMethod, _jpype._JClass)):
+        target._setGILPolicy(code)
+    else:
+        raise TypeError("GIL policy target must be a Java method or class")
+
+
+def preload(patterns, threads=None):
+    """ Load Java classes on background threads.
+
+    The first use of a Java class must create its wrapper and resolve
+    all of its methods.  For large libraries this can dominate the start
+    up time of a program.  Preloading performs this work on Java threads
+    while Python continues.  Classes requested by Python in the meantime
+    are loaded as usual.
+
+    Arguments:
+        patterns (list[str]): Names of classes, or package names ending
+          in ``.*`` to load every public class in the package and its
+          subpackages.
+        threads (int, optional): The number of threads to use.  Defaults
+          to one per processor.
+
+    Returns:
+        A handle for the preload.  ``getLoaded()``, ``getFailed()`` and
+        ``getTotal()`` give the progress, ``isDone()`` and
+        ``waitFor(millis)`` the completion, and ``getElapsed()`` the time
+        spent in seconds.
+
+    Example:
+
+    .. code-block:: python
+
+      task = jpype.preload(["com.acme.*", "org.example.Widget"], threads=4)
+      ...
+      task.waitFor(0)
+      print(task)
+
+    """
+    if isinstance(patterns, str):
+        patterns = [patterns]
+    return _jpype.JClass("org.jpype.manager.TypePreloader").start(
+        list(patterns), threads or 0)
+
+
 def getJVMVersion():
     """ Get the JVM version if the JVM is started.
 
@@ -0,0 +1,65 @@
+# *****************************************************************************
+#
+#   Licensed under the Apache License, Version 2.0 (the "License");
+#   you may not use this file except in compliance with the License.
+#   You may obtain a copy of the License at
+#
+#       http://www.apache.org/licenses/LICENSE-2.0
+#
+#   Unless required by applicable law or agreed to in writing, software
+#   distributed under the License is distributed on an "AS IS" BASIS,
+#   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#   See the License for the specific language governing permissions and
+#   limitations under the License.
+#
+#   See NOTICE file for details.
+#
+# *****************************************************************************
+import _jpype
+from . import _jcustomizer
+
+
+def _setResult(future, result):
+    if not future.cancelled():
+        future.set_result(result)
+
+
+def _setException(future, ex):
+    if not future.cancelled():
+        future.set_exception(ex)
+
+
+def _toFuture(stage, loop):
+    """ (internal) Create an asyncio future completed by a Java stage.
+
+    Java completes the future through a callback so no thread is used to
+    wait for the result.
+    """
+    future = loop.create_future()
+
+    def complete(result, ex):
+        if ex is not None:
+            # Unwrap the exception that caused the stage to fail
+            cause = ex.getCause()
+            if isinstance(ex, _jpype.JClass("java.util.concurrent.CompletionException")) \
+                    and cause is not None:
+                ex = cause
+            loop.call_soon_threadsafe(_setException, future, ex)
+        else:
+            loop.call_soon_threadsafe(_setResult, future, result)
+    stage.whenComplete(complete)
+    return future
+
+
+@_jcustomizer.JImplementationFor("java.util.concurrent.CompletionStage")
+class _JCompletionStage(object):
+    """ Customizer for ``java.util.concurrent.CompletionStage``
+
+    This allows a ``CompletableFuture`` returned from Java to be awaited
+    in a coroutine.  Java completes the awaiting future through a callback
+    so no thread is used to wait for the result.
+    """
+
+    def __await__(self):
+        import asyncio
+        return _toFuture(self, asyncio.get_running_loop()).__await__()
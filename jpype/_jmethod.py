@@ -130,6 +130,31 @@ def _jmethodGetCode(method):
     return call
 
 
+def _jmethodAsyncCall(method, *args):
+    """ Call a Java method without blocking the event loop.
+
+    The arguments are converted immediately and the call is then made by a
+    Java thread, so no Python thread is held while it runs.  The result is
+    delivered back to the running event loop when Java completes the call.
+    Primitive results are returned as their boxed Java type.
+
+    Example:
+
+    .. code-block:: python
+
+        async def fetch(client, url):
+            return await client.fetch.asyncCall(url)
+
+    Returns:
+      An ``asyncio.Future`` holding the result of the call.
+    """
+    import asyncio
+    from . import _jconcurrent
+    loop = asyncio.get_running_loop()
+    return _jconcurrent._toFuture(method._asyncCall(*args), loop)
+
+
+_jpype._JMethod.asyncCall = _jmethodAsyncCall
 _jpype.getMethodDoc = _jmethodGetDoc
 _jpype.getMethodAnnotations = _jmethodGetAnnotation
 _jpype.getMethodCode = _jmethodGetCode
@@ -54,11 +54,18 @@ def _prepareInterfaces(cls, intf):
     return actualIntf
 
 
-def _createJProxyDeferred(cls, *intf):
+def _proxyOptions(asynchronous=False, batchSize=0, batchLatency=0.01):
+    """ (internal) Pack the delivery options for a proxy. """
+    return (asynchronous, batchSize, int(batchLatency * 1e9))
+
+
+def _createJProxyDeferred(cls, *intf, **kwargs):
     """ (internal) Create a proxy from a Python class with
     @JOverride notation on methods evaluated at first
     instantiation.
     """
+    options = _proxyOptions(**kwargs)
+
     def new(tp, *args, **kwargs):
         # Attach a __jpype_interfaces__ attribute to this class if
         # one doesn't already exist.
@@ -66,21 +73,22 @@ def _createJProxyDeferred(cls, *intf):
         if actualIntf is None:
             actualIntf = _prepareInterfaces(cls, intf)
             tp.__jpype_interfaces__ = actualIntf
-        return _jpype._JProxy.__new__(tp, None, actualIntf)
+        return _jpype._JProxy.__new__(tp, None, actualIntf, False, *options)
 
     members = {'__new__': new}
     # Return the augmented class
     return type("proxy.%s" % cls.__name__, (cls, _jpype._JProxy), members)
 
 
-def _createJProxy(cls, *intf):
+def _createJProxy(cls, *intf, **kwargs):
     """ (internal) Create a proxy from a Python class with
     @JOverride notation on methods evaluated at declaration.
     """
+    options = _proxyOptions(**kwargs)
     actualIntf = _prepareInterfaces(cls, intf)
 
     def new(tp, *args, **kwargs):
-        self = _jpype._JProxy.__new__(tp, None, actualIntf)
+        self = _jpype._JProxy.__new__(tp, None, actualIntf, False, *options)
         tp.__init__(self, *args, **kwargs)
         return self
 
@@ -110,6 +118,21 @@ def JImplements(*interfaces, deferred=False, **kwargs):
         (False). Deferred validation allows a proxy class to be declared prior
         to starting the JVM.  Validation only occurs once per proxy class,
         thus there is no performance penalty.  Default False.
+      asynchronous (bool):
+        Whether Java calls to methods returning ``void``, ``Future``,
+        ``CompletionStage`` or ``CompletableFuture`` should be queued to a
+        Java worker thread rather than waiting for the GIL.  Methods returning
+        a future receive a ``CompletableFuture`` which completes with the
+        value returned by Python.  Other methods are called as normal.
+        Default False.
+      batchSize (int):
+        If greater than zero, calls to methods returning ``void`` are
+        collected and delivered together.  The Python method receives a
+        list with the tuple of arguments for each call.  A batch is
+        delivered when it holds ``batchSize`` calls.  Default 0.
+      batchLatency (float):
+        The longest time in seconds a batched call may wait before it
+        is delivered.  Default 0.01.
 
     Example:
 
@@ -208,20 +231,28 @@ class JProxy(_jpype._JProxy):
             java interface methods.
         inst (object, optional): specifies an object with methods
             whose names matches the java interfaces methods.
+        asynchronous (bool, optional): queue calls to methods returning
+            void or a future to a Java worker thread rather than blocking
+            the caller on the GIL.
+        batchSize (int, optional): deliver calls to methods returning void
+            in lists of up to this many argument tuples.
+        batchLatency (float, optional): longest time in seconds a batched
+            call may wait for delivery.
     """
-    def __new__(cls, intf, dict=None, inst=None, convert=False):
+    def __new__(cls, intf, dict=None, inst=None, convert=False, **kwargs):
         # Convert the interfaces
         actualIntf = _convertInterfaces([intf])
+        options = _proxyOptions(**kwargs)
 
         # Verify that one of the options has been selected
         if dict is not None and inst is not None:
             raise TypeError("Specify only one of dict and inst")
 
         if dict is not None:
-            return _jpype._JProxy(_JFromDict(dict), actualIntf, convert)
+            return _jpype._JProxy(_JFromDict(dict), actualIntf, convert, *options)
 
         if inst is not None:
-            return _jpype._JProxy.__new__(cls, inst, actualIntf, convert)
+            return _jpype._JProxy.__new__(cls, inst, actualIntf, convert, *options)
 
         raise TypeError("a dict or inst must be specified")
 
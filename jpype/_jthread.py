@@ -81,3 +81,70 @@ class _JThread(object):
         and there is no harm in calling it when the JVM is not running.
         """
         return _jpype.detachThreadFromJVM()
+
+    @staticmethod
+    def setAutoDetach(enable):
+        """ Detach threads from the JVM when they terminate.
+
+        Threads that JPype attaches, either automatically or through
+        ``attach``, are normally attached until ``detach`` is called.
+        Applications which create many short lived threads leak a Java
+        thread object for each one.  When enabled, such threads are
+        detached as they exit.  Threads created by Java are not affected.
+
+        Args:
+          enable (bool): True to detach threads on exit.
+        """
+        _jpype._setAutoDetach(enable)
+
+    @staticmethod
+    def attachPool(executor, workers, timeout=1.0):
+        """ Attach the workers of a thread pool to the JVM as daemons.
+
+        Worker threads are normally attached the first time they call Java.
+        This submits one task per worker to a
+        ``concurrent.futures.ThreadPoolExecutor`` and holds each task until
+        all have started so that every worker attaches up front.  If the
+        workers are not all free within the timeout the tasks are released
+        and only the workers reached are attached.
+
+        Pools created by the caller can instead attach each worker as it
+        starts by passing ``initializer=java.lang.Thread.attachAsDaemon``
+        to the executor.
+
+        Args:
+          executor: The thread pool executor to attach.
+          workers (int): The number of workers in the pool.
+          timeout (float, optional): The longest time in seconds to wait
+            for the workers to start.
+
+        Returns:
+          The number of workers attached.
+
+        Raises:
+          RuntimeError: If the JVM is not running.
+        """
+        import threading
+        barrier = threading.Barrier(workers, timeout=timeout)
+        attached = set()
+
+        def attach():
+            _jpype.attachThreadAsDaemon()
+            attached.add(threading.get_ident())
+            try:
+                barrier.wait()
+            except threading.BrokenBarrierError:
+                pass
+        for future in [executor.submit(attach) for i in range(workers)]:
+            future.result()
+        return len(attached)
+
+    @staticmethod
+    def getAttachStats():
+        """ Get the number of threads attached and detached by JPype.
+
+        Returns:
+          A dict with the counts of ``attached``, ``detached`` and
+          ``autoDetached`` threads.
+        """
+        return _jpype._getThreadStats()
@@ -1,3 +1,6 @@
+import typing
+
+
 class _JThread:
     @staticmethod
     def isAttached() -> bool: ...
@@ -10,3 +13,12 @@ class _JThread:
 
     @staticmethod
     def detach() -> None: ...
+
+    @staticmethod
+    def setAutoDetach(enable: bool) -> None: ...
+
+    @staticmethod
+    def attachPool(executor: typing.Any, workers: int, timeout: float = 1.0) -> int: ...
+
+    @staticmethod
+    def getAttachStats() -> typing.Dict[str, int]: ...
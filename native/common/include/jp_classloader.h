@@ -45,12 +45,20 @@ public:
 	// Classloader for Proxy
 	jobject getBootLoader();
 
+	/** Get the number of times the class path has changed.
+	 *
+	 * This is used to invalidate the names that were not found
+	 * in a package.
+	 */
+	jint getGeneration(JPJavaFrame& frame);
+
 private:
 	JPContext* m_Context;
 	JPClassRef m_ClassClass;
 	JPObjectRef m_SystemClassLoader;
 	JPObjectRef m_BootLoader;
 	jmethodID m_ForNameID;
+	jfieldID m_GenerationID;
 } ;
 
 #endif // _JPCLASSLOADER_H_
\ No newline at end of file
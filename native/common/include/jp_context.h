@@ -133,6 +133,12 @@ public:
 	bool isThreadAttached();
 	void detachCurrentThread();
 
+	/** Detach threads attached by JPype when they terminate. */
+	void setAutoDetach(bool enable);
+
+	/** Get the number of threads attached and detached by JPype. */
+	void getThreadStats(jlong& attached, jlong& detached, jlong& autoDetached);
+
 	JNIEnv* getEnv();
 
 	JavaVM* getJavaVM()
@@ -230,6 +236,7 @@ private:
 	jmethodID m_Object_EqualsID;
 	jmethodID m_Object_HashCodeID;
 	jmethodID m_CallMethodID;
+	jmethodID m_CallMethodAsyncID;
 	jmethodID m_Class_GetNameID;
 	jmethodID m_Context_collectRectangularID;
 	jmethodID m_Context_assembleID;
@@ -255,6 +262,7 @@ private:
 	jmethodID m_Context_GetPackageID;
 	jmethodID m_Package_GetObjectID;
 	jmethodID m_Package_GetContentsID;
+	jfieldID m_Package_DirectoryID;
 	jmethodID m_Context_NewWrapperID;
 public:
 	jmethodID m_Context_GetStackFrameID;
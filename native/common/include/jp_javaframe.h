@@ -51,6 +51,8 @@ class JPJavaFrame
 	JNIEnv* m_Env;
 	bool m_Popped;
 	bool m_Outer;
+	bool m_ReleaseGIL;
+	jlong* m_CallTime;
 
 private:
 	JPJavaFrame(JPContext* context, JNIEnv* env, int size, bool outer);
@@ -114,6 +116,36 @@ public:
 
 	void check();
 
+	/** Check if a method call through this frame should release the GIL.
+	 *
+	 * This is set by JPMethodDispatch according to the GIL policy of the
+	 * method being called.
+	 */
+	bool isReleaseGIL() const
+	{
+		return m_ReleaseGIL;
+	}
+
+	void setReleaseGIL(bool release)
+	{
+		m_ReleaseGIL = release;
+	}
+
+	/** Get where the time of the next Java call is recorded.
+	 *
+	 * @return the location for the time in nanoseconds or NULL if the
+	 * call is not timed.
+	 */
+	jlong* getCallTime() const
+	{
+		return m_CallTime;
+	}
+
+	void setCallTime(jlong* time)
+	{
+		m_CallTime = time;
+	}
+
 	/** Exit the local frame and keep a local reference to an object
 	 *
 	 * This must be called only once when the frame is about to leave
@@ -187,6 +219,7 @@ public:
 	 */
 	jstring fromStringUTF8(const string& str);
 	jobject callMethod(jobject method, jobject obj, jobject args);
+	jobject callMethodAsync(jobject method, jobject obj, jobject args);
 	jobject toCharArray(jstring jstr);
 	string getFunctional(jclass c);
 
@@ -227,6 +260,7 @@ public:
 
 	jboolean IsInstanceOf(jobject a0, jclass a1);
 	jboolean IsAssignableFrom(jclass a0, jclass a1);
+	jboolean IsSameObject(jobject a0, jobject a1);
 
 	jsize GetArrayLength(jarray a0);
 	jobject GetObjectArrayElement(jobjectArray a0, jsize a1);
@@ -387,6 +421,7 @@ public:
 	jobject getPackage(const string& str);
 	jobject getPackageObject(jobject pkg, const string& str);
 	jarray getPackageContents(jobject pkg);
+	bool isPackageDirectory(jobject pkg);
 
 	void newWrapper(JPClass* cls);
 	void registerRef(jobject obj, PyObject* hostRef);
@@ -49,9 +49,42 @@ public:
 	 */
 	JPMatch::Type matches(JPJavaFrame &frame, JPMethodMatch& match, bool isInstance, JPPyObjectVector& args);
 	JPPyObject invoke(JPJavaFrame &frame, JPMethodMatch& match, JPPyObjectVector& arg, bool instance);
-	JPPyObject invokeCallerSensitive(JPMethodMatch& match, JPPyObjectVector& arg, bool instance);
+	JPPyObject invokeCallerSensitive(JPJavaFrame &caller, JPMethodMatch& match, JPPyObjectVector& arg, bool instance);
+
+	/** Start a call on a Java thread.
+	 *
+	 * The arguments are converted now and the call is made by Java
+	 * without holding a Python thread.
+	 *
+	 * @return a CompletableFuture for the result.
+	 */
+	JPPyObject invokeAsync(JPJavaFrame &frame, JPMethodMatch& match, JPPyObjectVector& arg);
 	JPValue invokeConstructor(JPJavaFrame &frame, JPMethodMatch& match, JPPyObjectVector& arg);
 
+	/** Convert the arguments for a call that will be made later with
+	 * invokeMany.
+	 *
+	 * The object to call is stored after the arguments.
+	 */
+	void packCall(JPJavaFrame &frame, JPMethodMatch& match, JPPyObjectVector& arg, vector<jvalue>& v);
+
+	/** Make a series of packed calls.
+	 *
+	 * All of the calls are made within a single release of the GIL and
+	 * the results are then appended to a Python list.
+	 *
+	 * @param calls is the list of packed calls.
+	 * @param instance is true if this was called on a bound method.
+	 * @param out is the list to receive the results.
+	 */
+	void invokeMany(JPJavaFrame &frame, vector<vector<jvalue> >& calls, bool instance, PyObject* out);
+
+	JPClass* getReturnType()
+	{
+		ensureTypeCache();
+		return m_ReturnType;
+	}
+
 	bool isAbstract() const
 	{
 		return JPModifier::isAbstract(m_Modifiers);
@@ -99,6 +132,7 @@ public:
 
 private:
 	void packArgs(JPJavaFrame &frame, JPMethodMatch &match, vector<jvalue> &v, JPPyObjectVector &arg);
+	jobjectArray packBoxed(JPJavaFrame &frame, JPMethodMatch &match, JPPyObjectVector &arg, jobject& self);
 	void ensureTypeCache();
 
 	JPMethod(const JPMethod& o);
@@ -16,12 +16,25 @@
 #ifndef _JPMETHODDISPATCH_H_
 #define _JPMETHODDISPATCH_H_
 
+#include <atomic>
 #include "jp_class.h"
 
 class JPMethodDispatch : public JPResource
 {
 public:
 
+	/** Policy for releasing the GIL while a Java method runs.
+	 */
+	enum GILPolicy
+	{
+		// Always release (default)
+		_gil_release = 0,
+		// Never release, for trivial methods which never block
+		_gil_hold = 1,
+		// Measure the first calls and hold the GIL if they are trivial
+		_gil_adaptive = 2
+	} ;
+
 	/**
 	 * Create a new method based on class and a name;
 	 */
@@ -30,6 +43,13 @@ public:
 			JPMethodList& overloads,
 			jint modifiers);
 
+	/**
+	 * Create a method whose overloads will be resolved when first used.
+	 */
+	JPMethodDispatch(JPClass *clazz,
+			const string& name,
+			jint modifiers);
+
 	virtual ~JPMethodDispatch();
 
 private:
@@ -67,15 +87,63 @@ public:
 
 	JPPyObject invoke(JPJavaFrame& frame, JPPyObjectVector& vargs, bool instance);
 	JPValue invokeConstructor(JPJavaFrame& frame, JPPyObjectVector& vargs);
+
+	/** Call the method once for each argument tuple in an iterable.
+	 *
+	 * Arguments are converted in blocks and each block of calls is made
+	 * within a single release of the GIL.
+	 *
+	 * @param self is the bound instance or NULL.
+	 * @param rows is an iterable of argument tuples.
+	 * @return a list of results, or None if the method is void.
+	 */
+	JPPyObject invokeMany(JPJavaFrame& frame, PyObject* self, PyObject* rows);
+
+	/** Start a call on a Java thread.
+	 *
+	 * @return a CompletableFuture for the result.
+	 */
+	JPPyObject invokeAsync(JPJavaFrame& frame, JPPyObjectVector& vargs, bool instance);
 	bool matches(JPJavaFrame& frame, JPPyObjectVector& args, bool instance);
 
 	string matchReport(JPPyObjectVector& sequence);
 
 	const JPMethodList& getMethodOverloads()
 	{
+		ensureOverloads();
 		return m_Overloads;
 	}
 
+	void assignOverloads(JPMethodList& overloads);
+
+	/** Set the GIL policy for calls through this dispatch.
+	 *
+	 * The policy belongs to the dispatch rather than the overloads so that
+	 * setting it on a class does not change the methods inherited from
+	 * its base classes.
+	 */
+	void setGILPolicy(int policy);
+
+	int getGILPolicy() const
+	{
+		return m_GILPolicy;
+	}
+
+	/** Check if the GIL should be released for the next call. */
+	bool isReleaseGIL() const
+	{
+		return m_GILPolicy == _gil_release
+				|| (m_GILPolicy == _gil_adaptive && !m_GILHold);
+	}
+
+	/** Update the adaptive GIL policy with the time taken by a Java call.
+	 *
+	 * This is only called with the GIL held.
+	 *
+	 * @param elapsed is the time of the call in nanoseconds.
+	 */
+	void recordCall(jlong elapsed);
+
 private:
 	/** Search for a matching overload.
 	 *
@@ -83,13 +151,24 @@ private:
 	 * when matching with a non-static.
 	 */
 	bool findOverload(JPJavaFrame& frame, JPMethodMatch &bestMatch, JPPyObjectVector& vargs, bool searchInstance, bool raise);
+	JPMethod* packMany(JPJavaFrame& frame, JPPyObjectVector& vargs, bool instance,
+			vector<vector<jvalue> >& calls, JPMethod* current, PyObject* out);
 	void dumpOverloads();
+	void ensureOverloads();
 
 	JPClass*      m_Class;
 	string        m_Name;
 	JPMethodList  m_Overloads;
 	jlong         m_Modifiers;
 	JPMethodCache m_LastCache;
+	// Overloads may be resolved by a preload thread.
+	std::atomic<bool> m_Resolved;
+
+	// State for the adaptive GIL policy
+	int           m_GILPolicy;
+	bool          m_GILHold;
+	int           m_GILSamples;
+	jlong         m_GILTime;
 } ;
 
 #endif // _JPMETHODDISPATCH_H_
\ No newline at end of file
@@ -20,11 +20,57 @@ struct PyJPProxy;
 class JPProxy;
 class JPFunctional;
 
+/** Resolved plan for calling a Python method from Java.
+ *
+ * The parameter and return types are fixed by the interface method, so
+ * the conversions are decided once when the method is first called.
+ */
+struct JPProxyMethod
+{
+	JPProxyMethod()
+	: m_Callable(NULL), m_ReturnType(NULL), m_BoxedReturnType(NULL)
+	{
+	}
+
+	PyObject*    m_Callable;
+	JPClass*     m_ReturnType;
+
+	// Box to use for primitive returns
+	JPBoxedType* m_BoxedReturnType;
+
+	// The declared type of each parameter
+	JPClassList  m_ParameterTypes;
+
+	// The type to convert each argument with, or NULL if the type must be
+	// found from the object.
+	JPClassList  m_ArgumentTypes;
+} ;
+
+/** Options controlling how Java calls are delivered to a proxy.
+ */
+struct JPProxyOptions
+{
+	JPProxyOptions()
+	: m_Asynchronous(false), m_BatchSize(0), m_BatchLatency(0)
+	{
+	}
+
+	// Queue methods returning void or a future rather than blocking the caller
+	bool  m_Asynchronous;
+
+	// Maximum number of void calls to deliver together, or 0 for no batching
+	jint  m_BatchSize;
+
+	// Longest time a batched call may wait for delivery in nanoseconds
+	jlong m_BatchLatency;
+} ;
+
 class JPProxy
 {
 public:
 	friend class JPProxyType;
-	JPProxy(JPContext* context, PyJPProxy* inst, JPClassList& intf);
+	JPProxy(JPContext* context, PyJPProxy* inst, JPClassList& intf,
+			const JPProxyOptions& options);
 	virtual ~JPProxy();
 
 	const JPClassList& getInterfaces() const
@@ -40,6 +86,25 @@ public:
 	}
 
 	virtual JPPyObject getCallable(const string& cname) = 0;
+
+	/** Get the plan for calling a method using the cache.
+	 *
+	 * The index is assigned by JPypeProxy and is stable for the lifetime
+	 * of the proxy.  The name and types are only examined when the cache
+	 * misses.
+	 *
+	 * Plans are never moved or altered once created, so the reference
+	 * remains valid if Python calls back into the proxy.  The callable may
+	 * be cleared by the garbage collector, so callers must hold their own
+	 * reference to it while calling.
+	 */
+	JPProxyMethod& getMethod(JPJavaFrame& frame, jint index, jstring name,
+			jlong returnType, jlongArray parameterTypes);
+
+	/** Support for the Python garbage collector. */
+	int traverseCallables(visitproc visit, void *arg);
+	void clearCallables();
+
 	static void releaseProxyPython(void* host);
 
 protected:
@@ -48,12 +113,14 @@ protected:
 	JPObjectRef   m_Proxy;
 	JPClassList   m_InterfaceClasses;
 	jweak         m_Ref;
+	vector<JPProxyMethod*> m_Methods;
 } ;
 
 class JPProxyDirect : public JPProxy
 {
 public:
-	JPProxyDirect(JPContext* context, PyJPProxy* inst, JPClassList& intf);
+	JPProxyDirect(JPContext* context, PyJPProxy* inst, JPClassList& intf,
+			const JPProxyOptions& options);
 	virtual ~JPProxyDirect();
 	virtual JPPyObject getCallable(const string& cname) override;
 } ;
@@ -61,7 +128,8 @@ public:
 class JPProxyIndirect : public JPProxy
 {
 public:
-	JPProxyIndirect(JPContext* context, PyJPProxy* inst, JPClassList& intf);
+	JPProxyIndirect(JPContext* context, PyJPProxy* inst, JPClassList& intf,
+			const JPProxyOptions& options);
 	virtual ~JPProxyIndirect();
 	virtual JPPyObject getCallable(const string& cname) override;
 } ;
@@ -21,6 +21,20 @@ namespace JPReferenceQueue
 {
 void registerRef(JPJavaFrame &frame, jobject obj, PyObject*  targetRef);
 void registerRef(JPJavaFrame &frame, jobject obj, void* host, JCleanupHook func);
+
+/** Send all staged references to Java.
+ *
+ * References are registered in batches to reduce the number of calls
+ * into Java.  This must be called with the GIL held.
+ */
+void flush(JPJavaFrame &frame);
+
+/** Send the staged references to Java if they have been held too long.
+ *
+ * This must be called with the GIL held.
+ */
+void flushAged(JPJavaFrame &frame);
+bool hasPending();
 } ; // end of namespace JPReferenceQueue
 
 #endif
\ No newline at end of file
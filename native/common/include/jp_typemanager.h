@@ -39,8 +39,31 @@ public:
 	JPClass* findClass(jclass cls);
 	JPClass* findClassByName(const string& str);
 	JPClass* findClassForObject(jobject obj);
+
+	/**
+	 * Find the class of a Java exception.
+	 *
+	 * Programs tend to throw the same few exceptions repeatedly so the
+	 * classes of recent exceptions are kept to avoid calling Java.  Python
+	 * exceptions in transit are never cached as they must be unwrapped
+	 * rather than converted, nor are anonymous classes as their wrapper
+	 * does not hold their own class.
+	 *
+	 * This must be called while holding the GIL.
+	 *
+	 * The pointer returned is NOT owned by the caller
+	 */
+	JPClass* findClassForThrowable(JPJavaFrame& frame, jthrowable th);
+
+	/**
+	 * Find the class of a Java exception if it was seen recently.
+	 *
+	 * @return the class or NULL if it is not in the cache.
+	 */
+	JPClass* findCachedThrowable(JPJavaFrame& frame, jthrowable th);
 	void populateMethod(void* method, jobject obj);
 	void populateMembers(JPClass* cls);
+	void populateDispatch(JPMethodDispatch* dispatch);
 
 private:
 	JPContext* m_Context;
@@ -50,6 +73,11 @@ private:
 	jmethodID m_FindClassForObject;
 	jmethodID m_PopulateMethod;
 	jmethodID m_PopulateMembers;
+	jmethodID m_PopulateDispatch;
+
+	static const int THROWABLE_CACHE_SIZE = 16;
+	JPClass* m_ThrowableCache[THROWABLE_CACHE_SIZE];
+	int m_ThrowableCacheSize;
 } ;
 
 #endif // _JPCLASS_H_
\ No newline at end of file
@@ -193,7 +193,7 @@ JPPyObject JPBooleanType::invokeStatic(JPJavaFrame& frame, jclass claz, jmethodI
 {
 	jvalue v;
 	{
-		JPPyCallRelease call;
+		JPPyCallRelease call(frame);
 		field(v) = frame.CallStaticBooleanMethodA(claz, mth, val);
 	}
 	return convertToPythonObject(frame, v, false);
@@ -203,7 +203,7 @@ JPPyObject JPBooleanType::invoke(JPJavaFrame& frame, jobject obj, jclass clazz,
 {
 	jvalue v;
 	{
-		JPPyCallRelease call;
+		JPPyCallRelease call(frame);
 		if (clazz == NULL)
 			field(v) = frame.CallBooleanMethodA(obj, mth, val);
 		else
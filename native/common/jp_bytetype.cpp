@@ -126,7 +126,7 @@ JPPyObject JPByteType::invokeStatic(JPJavaFrame& frame, jclass claz, jmethodID m
 {
 	jvalue v;
 	{
-		JPPyCallRelease call;
+		JPPyCallRelease call(frame);
 		field(v) = frame.CallStaticByteMethodA(claz, mth, val);
 	}
 	return convertToPythonObject(frame, v, false);
@@ -136,7 +136,7 @@ JPPyObject JPByteType::invoke(JPJavaFrame& frame, jobject obj, jclass clazz, jme
 {
 	jvalue v;
 	{
-		JPPyCallRelease call;
+		JPPyCallRelease call(frame);
 		if (clazz == NULL)
 			field(v) = frame.CallByteMethodA(obj, mth, val);
 		else
@@ -168,7 +168,7 @@ JPPyObject JPCharType::invokeStatic(JPJavaFrame& frame, jclass claz, jmethodID m
 {
 	jvalue v;
 	{
-		JPPyCallRelease call;
+		JPPyCallRelease call(frame);
 		field(v) = frame.CallStaticCharMethodA(claz, mth, val);
 	}
 	return convertToPythonObject(frame, v, false);
@@ -178,7 +178,7 @@ JPPyObject JPCharType::invoke(JPJavaFrame& frame, jobject obj, jclass clazz, jme
 {
 	jvalue v;
 	{
-		JPPyCallRelease call;
+		JPPyCallRelease call(frame);
 		if (clazz == NULL)
 			field(v) = frame.CallCharMethodA(obj, mth, val);
 		else
@@ -189,7 +189,7 @@ JPPyObject JPClass::invokeStatic(JPJavaFrame& frame, jclass claz, jmethodID mth,
 	JP_TRACE_IN("JPClass::invokeStatic");
 	jvalue v;
 	{
-		JPPyCallRelease call;
+		JPPyCallRelease call(frame);
 		v.l = frame.CallStaticObjectMethodA(claz, mth, val);
 	}
 
@@ -209,7 +209,7 @@ JPPyObject JPClass::invoke(JPJavaFrame& frame, jobject obj, jclass clazz, jmetho
 
 	// Call method
 	{
-		JPPyCallRelease call;
+		JPPyCallRelease call(frame);
 		if (obj == NULL)
 			JP_RAISE(PyExc_ValueError, "method called on null object");
 		if (clazz == NULL)
@@ -365,23 +365,12 @@ JPPyObject JPClass::convertToPythonObject(JPJavaFrame& frame, jvalue value, bool
 
 	if (isThrowable())
 	{
+		// The message is fetched when the arguments are first used.
 		JPPyObject tuple0;
 		if (value.l == NULL)
-		{
 			tuple0 = JPPyObject::call(PyTuple_New(0));
-		} else
-		{
-			jstring m = frame.getMessage((jthrowable) value.l);
-			if (m != NULL)
-			{
-				tuple0 = JPPyObject::call(PyTuple_Pack(1,
-						JPPyString::fromStringUTF8(frame.toStringUTF8(m)).get()));
-			} else
-			{
-				tuple0 = JPPyObject::call(PyTuple_Pack(1,
-						JPPyString::fromStringUTF8(frame.toString(value.l)).get()));
-			}
-		}
+		else
+			tuple0 = JPPyObject::call(PyTuple_Pack(1, _JObjectKey));
 		JPPyObject tuple1 = JPPyObject::call(PyTuple_Pack(2,
 				_JObjectKey, tuple0.get()));
 		// Exceptions need new and init
@@ -23,6 +23,11 @@ jobject JPClassLoader::getBootLoader()
 	return m_BootLoader.get();
 }
 
+jint JPClassLoader::getGeneration(JPJavaFrame& frame)
+{
+	return frame.GetIntField(m_BootLoader.get(), m_GenerationID);
+}
+
 static jobject toURL(JPJavaFrame &frame, const string& path)
 {
 	//  file = new File("org.jpype.jar");
@@ -64,6 +69,7 @@ JPClassLoader::JPClassLoader(JPJavaFrame& frame)
 		jvalue v;
 		v.l = m_SystemClassLoader.get();
 		m_BootLoader = JPObjectRef(frame, frame.NewObjectA(dynamicLoaderClass, newDyLoader, &v));
+		m_GenerationID = frame.GetFieldID(dynamicLoaderClass, "generation", "I");
 		return;
 	}
 	frame.ExceptionClear();
@@ -105,6 +111,7 @@ JPClassLoader::JPClassLoader(JPJavaFrame& frame)
 	jmethodID newDyLoader = frame.GetMethodID(dyClass, "<init>", "(Ljava/lang/ClassLoader;)V");
 	v[0].l = cl;
 	m_BootLoader = JPObjectRef(frame, frame.NewObjectA(dyClass, newDyLoader, v));
+	m_GenerationID = frame.GetFieldID(dyClass, "generation", "I");
 
 	JP_TRACE_OUT;  // GCOVR_EXCL_LINE
 }
@@ -13,6 +13,7 @@
 
    See NOTICE file for details.
  *****************************************************************************/
+#include <atomic>
 #include "jpype.h"
 #include "pyjp.h"
 #include "jp_typemanager.h"
@@ -31,6 +32,80 @@
 #include "jp_proxy.h"
 #include "jp_platform.h"
 #include "jp_gc.h"
+#include "jp_reference_queue.h"
+
+// Each thread caches its JNI environment so that entering Java does not
+// need to query the JVM.  The cache is only valid for the generation in
+// which it was filled, which changes when the JVM is shut down.  The
+// generation is read by every thread and changed by the one shutting down.
+static std::atomic<int> s_EnvGeneration(1);
+static thread_local JNIEnv* s_Env = NULL;
+static thread_local int s_EnvThreadGeneration = 0;
+
+static inline void setThreadEnv(JNIEnv* env)
+{
+	s_Env = env;
+	s_EnvThreadGeneration = s_EnvGeneration;
+}
+
+static inline JNIEnv* getThreadEnv()
+{
+	if (s_EnvThreadGeneration != s_EnvGeneration)
+		return NULL;
+	return s_Env;
+}
+
+// Counters for thread attachment
+static std::atomic<long> s_AttachCount(0);
+static std::atomic<long> s_DetachCount(0);
+static std::atomic<long> s_AutoDetachCount(0);
+static bool s_AutoDetach = false;
+
+/**
+ * Detaches threads which JPype attached when they terminate.
+ *
+ * The destructor of a thread local runs as the thread exits, after Python
+ * has released the thread state.  Threads which were already attached
+ * when they entered Python, such as Java threads calling a proxy, are
+ * never marked and are left alone.
+ */
+class JPThreadGuard
+{
+public:
+
+	JPThreadGuard() : m_JavaVM(NULL), m_Generation(0)
+	{
+	}
+
+	~JPThreadGuard()
+	{
+		if (m_JavaVM == NULL || !s_AutoDetach || m_Generation != s_EnvGeneration)
+			return;
+		m_JavaVM->functions->DetachCurrentThread(m_JavaVM);
+		s_DetachCount++;
+		s_AutoDetachCount++;
+	}
+
+	void attached(JavaVM* vm)
+	{
+		m_JavaVM = vm;
+		m_Generation = s_EnvGeneration;
+		s_AttachCount++;
+	}
+
+	void detached()
+	{
+		if (m_JavaVM != NULL)
+			s_DetachCount++;
+		m_JavaVM = NULL;
+	}
+
+private:
+	JavaVM* m_JavaVM;
+	int m_Generation;
+} ;
+
+static thread_local JPThreadGuard s_ThreadGuard;
 
 JPResource::~JPResource()
 {
@@ -87,6 +162,7 @@ JPContext::JPContext()
 	m_Object_EqualsID = NULL;
 	m_Object_HashCodeID = NULL;
 	m_CallMethodID = NULL;
+	m_CallMethodAsyncID = NULL;
 	m_Class_GetNameID = NULL;
 	m_Context_collectRectangularID = NULL;
 	m_Context_assembleID = NULL;
@@ -306,6 +382,8 @@ void JPContext::initializeResources(JNIEnv* env, bool interrupt)
 	// messages
 	m_CallMethodID = frame.GetMethodID(contextClass, "callMethod",
 			"(Ljava/lang/reflect/Method;Ljava/lang/Object;[Ljava/lang/Object;)Ljava/lang/Object;");
+	m_CallMethodAsyncID = frame.GetMethodID(contextClass, "callMethodAsync",
+			"(Ljava/lang/reflect/Method;Ljava/lang/Object;[Ljava/lang/Object;)Ljava/util/concurrent/CompletableFuture;");
 	m_Context_collectRectangularID = frame.GetMethodID(contextClass,
 			"collectRectangular",
 			"(Ljava/lang/Object;)[Ljava/lang/Object;");
@@ -334,6 +412,7 @@ void JPContext::initializeResources(JNIEnv* env, bool interrupt)
 			"(Ljava/lang/String;)Ljava/lang/Object;");
 	m_Package_GetContentsID = frame.GetMethodID(packageClass, "getContents",
 			"()[Ljava/lang/String;");
+	m_Package_DirectoryID = frame.GetFieldID(packageClass, "directory", "Z");
 	m_Context_NewWrapperID = frame.GetMethodID(contextClass, "newWrapper",
 			"(J)V");
 
@@ -353,7 +432,7 @@ void JPContext::initializeResources(JNIEnv* env, bool interrupt)
 	m_ProxyClass = JPClassRef(frame, proxyClass);
 	m_Proxy_NewID = frame.GetStaticMethodID(m_ProxyClass.get(),
 			"newProxy",
-			"(Lorg/jpype/JPypeContext;JJ[Ljava/lang/Class;)Lorg/jpype/proxy/JPypeProxy;");
+			"(Lorg/jpype/JPypeContext;JJ[Ljava/lang/Class;ZIJ)Lorg/jpype/proxy/JPypeProxy;");
 	m_Proxy_NewInstanceID = frame.GetMethodID(m_ProxyClass.get(),
 			"newInstance",
 			"()Ljava/lang/Object;");
@@ -382,6 +461,12 @@ void JPContext::shutdownJVM()
 	//	if (m_Embedded)
 	//		JP_RAISE(PyExc_RuntimeError, "Cannot shutdown from embedded Python");
 
+	// Send any staged references to Java so they are released with the queue
+	{
+		JPJavaFrame frame = JPJavaFrame::outer(this);
+		JPReferenceQueue::flush(frame);
+	}
+
 	// Wait for all non-demon threads to terminate
 	JP_TRACE("Destroy JVM");
 	{
@@ -400,6 +485,7 @@ void JPContext::shutdownJVM()
 	// unload the jvm library
 	JP_TRACE("Unload JVM");
 	m_JavaVM = NULL;
+	s_EnvGeneration++;
 	JPPlatformAdapter::getAdapter()->unloadLibrary();
 	JP_TRACE_OUT;
 }
@@ -414,8 +500,10 @@ void JPContext::ReleaseGlobalRef(jobject obj)
 	// Get the environment and release the resource if we can.
 	// Do not attach the thread if called from an unattached thread it is
 	// likely a shutdown anyway.
-	JNIEnv* env;
-	jint res = m_JavaVM->functions->GetEnv(m_JavaVM, (void**) &env, USE_JNI_VERSION);
+	JNIEnv* env = getThreadEnv();
+	jint res = JNI_OK;
+	if (env == NULL)
+		res = m_JavaVM->functions->GetEnv(m_JavaVM, (void**) &env, USE_JNI_VERSION);
 	if (res != JNI_EDETACHED)
 		env->functions->DeleteGlobalRef(env, obj);
 	JP_TRACE_OUT;
@@ -427,17 +515,27 @@ void JPContext::ReleaseGlobalRef(jobject obj)
 void JPContext::attachCurrentThread()
 {
 	JNIEnv* env;
+	// Only threads attached here are counted and detached at exit
+	bool detached = m_JavaVM->functions->GetEnv(m_JavaVM, (void**) &env, USE_JNI_VERSION) == JNI_EDETACHED;
 	jint res = m_JavaVM->functions->AttachCurrentThread(m_JavaVM, (void**) &env, NULL);
 	if (res != JNI_OK)
 		JP_RAISE(PyExc_RuntimeError, "Unable to attach to thread");
+	setThreadEnv(env);
+	if (detached)
+		s_ThreadGuard.attached(m_JavaVM);
 }
 
 void JPContext::attachCurrentThreadAsDaemon()
 {
 	JNIEnv* env;
+	// Only threads attached here are counted and detached at exit
+	bool detached = m_JavaVM->functions->GetEnv(m_JavaVM, (void**) &env, USE_JNI_VERSION) == JNI_EDETACHED;
 	jint res = m_JavaVM->functions->AttachCurrentThreadAsDaemon(m_JavaVM, (void**) &env, NULL);
 	if (res != JNI_OK)
 		JP_RAISE(PyExc_RuntimeError, "Unable to attach to thread as daemon");
+	setThreadEnv(env);
+	if (detached)
+		s_ThreadGuard.attached(m_JavaVM);
 }
 
 bool JPContext::isThreadAttached()
@@ -448,17 +546,35 @@ bool JPContext::isThreadAttached()
 
 void JPContext::detachCurrentThread()
 {
+	setThreadEnv(NULL);
+	s_ThreadGuard.detached();
 	m_JavaVM->functions->DetachCurrentThread(m_JavaVM);
 }
 
+void JPContext::setAutoDetach(bool enable)
+{
+	s_AutoDetach = enable;
+}
+
+void JPContext::getThreadStats(jlong& attached, jlong& detached, jlong& autoDetached)
+{
+	attached = s_AttachCount;
+	detached = s_DetachCount;
+	autoDetached = s_AutoDetachCount;
+}
+
 JNIEnv* JPContext::getEnv()
 {
-	JNIEnv* env = NULL;
 	if (m_JavaVM == NULL)
 	{
 		JP_RAISE(PyExc_RuntimeError, "JVM is null");
 	}
 
+	// Use the environment cached for this thread
+	JNIEnv* env = getThreadEnv();
+	if (env != NULL)
+		return env;
+
 	// Get the environment
 	jint res = m_JavaVM->functions->GetEnv(m_JavaVM, (void**) &env, USE_JNI_VERSION);
 
@@ -470,7 +586,9 @@ JNIEnv* JPContext::getEnv()
 		res = m_JavaVM->AttachCurrentThreadAsDaemon((void**) &env, NULL);
 		if (res != JNI_OK)
 			JP_RAISE(PyExc_RuntimeError, "Unable to attach to local thread");
+		s_ThreadGuard.attached(m_JavaVM);
 	}
+	setThreadEnv(env);
 	return env;
 }
 
@@ -172,7 +172,7 @@ JPPyObject JPDoubleType::invokeStatic(JPJavaFrame& frame, jclass claz, jmethodID
 {
 	jvalue v;
 	{
-		JPPyCallRelease call;
+		JPPyCallRelease call(frame);
 		field(v) = frame.CallStaticDoubleMethodA(claz, mth, val);
 	}
 	return convertToPythonObject(frame, v, false);
@@ -182,7 +182,7 @@ JPPyObject JPDoubleType::invoke(JPJavaFrame& frame, jobject obj, jclass clazz, j
 {
 	jvalue v;
 	{
-		JPPyCallRelease call;
+		JPPyCallRelease call(frame);
 		if (clazz == NULL)
 			field(v) = frame.CallDoubleMethodA(obj, mth, val);
 		else
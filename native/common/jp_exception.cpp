@@ -157,25 +157,33 @@ void JPypeException::convertJavaToPython()
 		return;
 	}
 	// GCOVR_EXCL_STOP
-	jlong pycls = frame.CallLongMethodA(m_Context->getJavaContext(), m_Context->m_Context_GetExcClassID, &v);
-	if (pycls != 0)
-	{
-		jlong value = frame.CallLongMethodA(m_Context->getJavaContext(), m_Context->m_Context_GetExcValueID, &v);
-		PyErr_SetObject((PyObject*) pycls, (PyObject*) value);
-		return;
-	}
-	JP_TRACE("Check typemanager");
-	// GCOVR_EXCL_START
-	if (!m_Context->isRunning())
+
+	// Exceptions of a recently seen class are converted without calling
+	// Java.  Python exceptions in transit are never in the cache.
+	JPClass* cls = NULL;
+	if (m_Context->isRunning())
+		cls = m_Context->getTypeManager()->findCachedThrowable(frame, th);
+	if (cls == NULL)
 	{
-		PyErr_SetString(PyExc_RuntimeError, frame.toString((jobject) th).c_str());
-		return;
-	}
-	// GCOVR_EXCL_STOP
+		jlong pycls = frame.CallLongMethodA(m_Context->getJavaContext(), m_Context->m_Context_GetExcClassID, &v);
+		if (pycls != 0)
+		{
+			jlong value = frame.CallLongMethodA(m_Context->getJavaContext(), m_Context->m_Context_GetExcValueID, &v);
+			PyErr_SetObject((PyObject*) pycls, (PyObject*) value);
+			return;
+		}
+		JP_TRACE("Check typemanager");
+		// GCOVR_EXCL_START
+		if (!m_Context->isRunning())
+		{
+			PyErr_SetString(PyExc_RuntimeError, frame.toString((jobject) th).c_str());
+			return;
+		}
+		// GCOVR_EXCL_STOP
 
-	// Convert to Python object
-	JP_TRACE("Convert to python");
-	JPClass* cls = frame.findClassForObject((jobject) th);
+		JP_TRACE("Find class");
+		cls = m_Context->getTypeManager()->findClassForThrowable(frame, th);
+	}
 
 	// GCOVR_EXCL_START
 	// This sanity check can only fail if the type system fails to find a
@@ -189,8 +197,9 @@ void JPypeException::convertJavaToPython()
 	// GCOVR_EXCL_STOP
 
 	// Create the exception object (this may fail)
+	JP_TRACE("Convert to python");
 	v.l = th;
-	JPPyObject pyvalue = cls->convertToPythonObject(frame, v, false);
+	JPPyObject pyvalue = cls->convertToPythonObject(frame, v, true);
 
 	// GCOVR_EXCL_START
 	// This sanity check can only be hit if the exception failed during
@@ -205,31 +214,8 @@ void JPypeException::convertJavaToPython()
 	PyObject *type = (PyObject*) Py_TYPE(pyvalue.get());
 	Py_INCREF(type);
 
-	// Add cause to the exception
-	JPPyObject args = JPPyObject::call(Py_BuildValue("(s)", "Java Exception"));
-	JPPyObject cause = JPPyObject::call(PyObject_Call(PyExc_Exception, args.get(), NULL));
-	JPPyObject trace = PyTrace_FromJavaException(frame, th, NULL);
-
-	// Attach Java causes as well.
-	try
-	{
-		jthrowable jcause = frame.getCause(th);
-		if (jcause != NULL)
-		{
-			jvalue a;
-			a.l = (jobject) jcause;
-			JPPyObject prev = frame.getContext()->_java_lang_Object->convertToPythonObject(frame, a, false);
-			PyJPException_normalize(frame, prev, jcause, th);
-			PyException_SetCause(cause.get(), prev.keep());
-		}
-		PyException_SetTraceback(cause.get(), trace.get());
-		PyException_SetCause(pyvalue.get(), cause.keep());
-	}	catch (JPypeException& ex)
-	{
-		JP_TRACE("FAILURE IN CAUSE");
-		// Any failures in this optional action should be ignored.
-		// worst case we don't print as much diagnostics.
-	}
+	// Add the Java stack frames and causes
+	PyJPException_attachCause(frame, pyvalue.get(), th);
 
 	// Transfer to Python
 	PyErr_SetObject(type, pyvalue.get());
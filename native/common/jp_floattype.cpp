@@ -155,7 +155,7 @@ JPPyObject JPFloatType::invokeStatic(JPJavaFrame& frame, jclass claz, jmethodID
 {
 	jvalue v;
 	{
-		JPPyCallRelease call;
+		JPPyCallRelease call(frame);
 		field(v) = frame.CallStaticFloatMethodA(claz, mth, val);
 	}
 	return convertToPythonObject(frame, v, false);
@@ -165,7 +165,7 @@ JPPyObject JPFloatType::invoke(JPJavaFrame& frame, jobject obj, jclass clazz, jm
 {
 	jvalue v;
 	{
-		JPPyCallRelease call;
+		JPPyCallRelease call(frame);
 		if (clazz == NULL)
 			field(v) = frame.CallFloatMethodA(obj, mth, val);
 		else
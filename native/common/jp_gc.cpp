@@ -186,6 +186,20 @@ void JPGarbageCollection::onEnd()
 	// coverage just creates random statistics.
 	if (!running)
 		return;
+
+	// Staged references must not be held past a collection.
+	if (JPReferenceQueue::hasPending())
+	{
+		try
+		{
+			JPJavaFrame frame = JPJavaFrame::outer(m_Context);
+			JPReferenceQueue::flush(frame);
+		} catch (JPypeException& ex)
+		{
+			// Cannot throw from a gc callback
+		}
+	}
+
 	if (java_triggered)
 	{
 		// Remove our lock so that we can watch for triggers
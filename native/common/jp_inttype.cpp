@@ -151,7 +151,7 @@ JPPyObject JPIntType::invokeStatic(JPJavaFrame& frame, jclass claz, jmethodID mt
 {
 	jvalue v;
 	{
-		JPPyCallRelease call;
+		JPPyCallRelease call(frame);
 		field(v) = frame.CallStaticIntMethodA(claz, mth, val);
 	}
 	return convertToPythonObject(frame, v, false);
@@ -161,7 +161,7 @@ JPPyObject JPIntType::invoke(JPJavaFrame& frame, jobject obj, jclass clazz, jmet
 {
 	jvalue v;
 	{
-		JPPyCallRelease call;
+		JPPyCallRelease call(frame);
 		if (clazz == NULL)
 			field(v) = frame.CallIntMethodA(obj, mth, val);
 		else
@@ -35,7 +35,8 @@ static void jpype_frame_check(int popped)
 #endif
 
 JPJavaFrame::JPJavaFrame(JPContext* context, JNIEnv* p_env, int size, bool outer)
-: m_Context(context), m_Env(p_env), m_Popped(false), m_Outer(outer)
+: m_Context(context), m_Env(p_env), m_Popped(false), m_Outer(outer), m_ReleaseGIL(true),
+m_CallTime(NULL)
 {
 	if (p_env == NULL)
 		m_Env = context->getEnv();
@@ -46,7 +47,8 @@ JPJavaFrame::JPJavaFrame(JPContext* context, JNIEnv* p_env, int size, bool outer
 }
 
 JPJavaFrame::JPJavaFrame(const JPJavaFrame& frame)
-: m_Context(frame.m_Context), m_Env(frame.m_Env), m_Popped(false), m_Outer(false)
+: m_Context(frame.m_Context), m_Env(frame.m_Env), m_Popped(false), m_Outer(false),
+m_ReleaseGIL(frame.m_ReleaseGIL), m_CallTime(NULL)
 {
 	// Create a memory management frame to live in
 	m_Env->PushLocalFrame(LOCAL_FRAME_DEFAULT);
@@ -68,6 +70,18 @@ jobject JPJavaFrame::keep(jobject obj)
 
 JPJavaFrame::~JPJavaFrame()
 {
+	// Staged references are sent when a call from Python completes so
+	// that they are not held without bound.
+	if (m_Outer && !m_Popped && JPReferenceQueue::hasPending() && PyGILState_Check())
+	{
+		try
+		{
+			JPReferenceQueue::flushAged(*this);
+		} catch (...) // GCOVR_EXCL_LINE
+		{
+		}
+	}
+
 	// Check if we have already closed the frame.
 	if (!m_Popped)
 	{
@@ -936,6 +950,12 @@ jboolean JPJavaFrame::IsAssignableFrom(jclass a0, jclass a1)
 			m_Env->IsAssignableFrom(a0, a1));
 }
 
+jboolean JPJavaFrame::IsSameObject(jobject a0, jobject a1)
+{
+	JAVA_RETURN(jboolean, "JPJavaFrame::IsSameObject",
+			m_Env->IsSameObject(a0, a1));
+}
+
 jstring JPJavaFrame::NewStringUTF(const char* a0)
 {
 	JAVA_RETURN_OBJ(jstring, "JPJavaFrame::NewString",
@@ -1166,6 +1186,18 @@ jobject JPJavaFrame::callMethod(jobject method, jobject obj, jobject args)
 	JP_TRACE_OUT;
 }
 
+jobject JPJavaFrame::callMethodAsync(jobject method, jobject obj, jobject args)
+{
+	JP_TRACE_IN("JPJavaFrame::callMethodAsync");
+	JPJavaFrame frame(*this);
+	jvalue v[3];
+	v[0].l = method;
+	v[1].l = obj;
+	v[2].l = args;
+	return frame.keep(frame.CallObjectMethodA(m_Context->m_JavaContext.get(), m_Context->m_CallMethodAsyncID, v));
+	JP_TRACE_OUT;
+}
+
 string JPJavaFrame::getFunctional(jclass c)
 {
 	jvalue v;
@@ -1238,6 +1270,11 @@ jarray JPJavaFrame::getPackageContents(jobject pkg)
 			(jarray) CallObjectMethodA(pkg, m_Context->m_Package_GetContentsID, &v));
 }
 
+bool JPJavaFrame::isPackageDirectory(jobject pkg)
+{
+	return GetBooleanField(pkg, m_Context->m_Package_DirectoryID) != 0;
+}
+
 void JPJavaFrame::newWrapper(JPClass* cls)
 {
 	JPPyCallRelease call;
@@ -151,7 +151,7 @@ JPPyObject JPLongType::invokeStatic(JPJavaFrame& frame, jclass claz, jmethodID m
 {
 	jvalue v;
 	{
-		JPPyCallRelease call;
+		JPPyCallRelease call(frame);
 		field(v) = frame.CallStaticLongMethodA(claz, mth, val);
 	}
 	return convertToPythonObject(frame, v, false);
@@ -161,7 +161,7 @@ JPPyObject JPLongType::invoke(JPJavaFrame& frame, jobject obj, jclass clazz, jme
 {
 	jvalue v;
 	{
-		JPPyCallRelease call;
+		JPPyCallRelease call(frame);
 		if (clazz == NULL)
 			field(v) = frame.CallLongMethodA(obj, mth, val);
 		else
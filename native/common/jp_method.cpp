@@ -208,7 +208,7 @@ JPPyObject JPMethod::invoke(JPJavaFrame& frame, JPMethodMatch& match, JPPyObject
 	JP_TRACE_IN("JPMethod::invoke");
 	// Check if it is caller sensitive
 	if (isCallerSensitive())
-		return invokeCallerSensitive(match, arg, instance);
+		return invokeCallerSensitive(frame, match, arg, instance);
 
 	size_t alen = m_ParameterTypes.size();
 	JPClass* retType = m_ReturnType;
@@ -251,21 +251,17 @@ JPPyObject JPMethod::invoke(JPJavaFrame& frame, JPMethodMatch& match, JPPyObject
 	JP_TRACE_OUT; // GCOVR_EXCL_LINE
 }
 
-JPPyObject JPMethod::invokeCallerSensitive(JPMethodMatch& match, JPPyObjectVector& arg, bool instance)
+jobjectArray JPMethod::packBoxed(JPJavaFrame& frame, JPMethodMatch& match, JPPyObjectVector& arg, jobject& self)
 {
-	JP_TRACE_IN("JPMethod::invokeCallerSensitive");
+	JP_TRACE_IN("JPMethod::packBoxed");
 	JPContext *context = m_Class->getContext();
 	size_t alen = m_ParameterTypes.size();
-	JPJavaFrame frame = JPJavaFrame::outer(context, (int) (8 + alen));
-	JPClass* retType = m_ReturnType;
 
 	// Pack the arguments
 	vector<jvalue> v(alen + 1);
 	packArgs(frame, match, v, arg);
 
-	//Proxy the call to
-	//   public static Object callMethod(Method method, Object obj, Object[] args)
-	jobject self = NULL;
+	self = NULL;
 	size_t len = alen;
 	if (!isStatic())
 	{
@@ -296,11 +292,29 @@ JPPyObject JPMethod::invokeCallerSensitive(JPMethodMatch& match, JPPyObjectVecto
 			frame.SetObjectArrayElement(ja, i, v[i].l);
 		}
 	}
+	return ja;
+	JP_TRACE_OUT;
+}
+
+JPPyObject JPMethod::invokeCallerSensitive(JPJavaFrame& caller, JPMethodMatch& match, JPPyObjectVector& arg, bool instance)
+{
+	JP_TRACE_IN("JPMethod::invokeCallerSensitive");
+	JPContext *context = m_Class->getContext();
+	size_t alen = m_ParameterTypes.size();
+	JPJavaFrame frame = JPJavaFrame::outer(context, (int) (8 + alen));
+	frame.setReleaseGIL(caller.isReleaseGIL());
+	frame.setCallTime(caller.getCallTime());
+	JPClass* retType = m_ReturnType;
+
+	//Proxy the call to
+	//   public static Object callMethod(Method method, Object obj, Object[] args)
+	jobject self;
+	jobjectArray ja = packBoxed(frame, match, arg, self);
 
 	// Call the method
 	jobject o;
 	{
-		JPPyCallRelease call;
+		JPPyCallRelease call(frame);
 		o =	 frame.callMethod(m_Method.get(), self, ja);
 	}
 
@@ -324,13 +338,126 @@ JPPyObject JPMethod::invokeCallerSensitive(JPMethodMatch& match, JPPyObjectVecto
 	JP_TRACE_OUT;
 }
 
+JPPyObject JPMethod::invokeAsync(JPJavaFrame& frame, JPMethodMatch& match, JPPyObjectVector& arg)
+{
+	JP_TRACE_IN("JPMethod::invokeAsync");
+	JPContext *context = m_Class->getContext();
+	jobject self;
+	jobjectArray ja = packBoxed(frame, match, arg, self);
+	jvalue v;
+	v.l = frame.callMethodAsync(m_Method.get(), self, ja);
+	return context->_java_lang_Object->convertToPythonObject(frame, v, false);
+	JP_TRACE_OUT;
+}
+
+void JPMethod::packCall(JPJavaFrame& frame, JPMethodMatch& match, JPPyObjectVector& arg, vector<jvalue>& v)
+{
+	JP_TRACE_IN("JPMethod::packCall");
+	size_t alen = m_ParameterTypes.size();
+	v.resize(alen + 1);
+	packArgs(frame, match, v, arg);
+	v[alen].l = NULL;
+	if (JPModifier::isStatic(m_Modifiers))
+		return;
+
+	// The row may hold the only reference to the object and is released
+	// before the call is made, so we need a local reference of our own.
+	JPValue* selfObj = PyJPValue_getJavaSlot(arg[0]);
+	if (selfObj == NULL)
+		v[alen] = match.m_Arguments[0].convert();
+	else
+		v[alen].l = frame.NewLocalRef(selfObj->getJavaObject());
+	if (v[alen].l == NULL)
+		JP_RAISE(PyExc_ValueError, "method called on null object");
+	JP_TRACE_OUT; // GCOVR_EXCL_LINE
+}
+
+#define JP_CALL_MANY(T, F) \
+	if (isStaticCall) \
+		F = frame.CallStatic##T##MethodA(clazz, m_MethodID, v); \
+	else if (clazz == NULL) \
+		F = frame.Call##T##MethodA(obj, m_MethodID, v); \
+	else \
+		F = frame.CallNonvirtual##T##MethodA(obj, clazz, m_MethodID, v); \
+	break;
+
+void JPMethod::invokeMany(JPJavaFrame& frame, vector<vector<jvalue> >& calls, bool instance, PyObject* out)
+{
+	JP_TRACE_IN("JPMethod::invokeMany");
+	ensureTypeCache();
+	size_t alen = m_ParameterTypes.size();
+	JPClass* retType = m_ReturnType;
+	char code = 'L';
+	if (retType->isPrimitive())
+		code = ((JPPrimitiveType*) retType)->getTypeCode();
+
+	bool isStaticCall = JPModifier::isStatic(m_Modifiers);
+	jclass clazz = NULL;
+	if (isStaticCall || (!isAbstract() && !instance))
+		clazz = m_Class->getJavaClass();
+
+	// Make all of the calls in one release of the GIL
+	vector<jvalue> results(calls.size());
+	{
+		JPPyCallRelease call(frame.isReleaseGIL());
+		for (size_t i = 0; i < calls.size(); ++i)
+		{
+			jvalue* v = &calls[i][0];
+			jobject obj = calls[i][alen].l;
+			jvalue& r = results[i];
+			switch (code)
+			{
+				case 'Z': JP_CALL_MANY(Boolean, r.z)
+				case 'B': JP_CALL_MANY(Byte, r.b)
+				case 'C': JP_CALL_MANY(Char, r.c)
+				case 'S': JP_CALL_MANY(Short, r.s)
+				case 'I': JP_CALL_MANY(Int, r.i)
+				case 'J': JP_CALL_MANY(Long, r.j)
+				case 'F': JP_CALL_MANY(Float, r.f)
+				case 'D': JP_CALL_MANY(Double, r.d)
+				case 'L': JP_CALL_MANY(Object, r.l)
+				case 'V':
+					if (isStaticCall)
+						frame.CallStaticVoidMethodA(clazz, m_MethodID, v);
+					else if (clazz == NULL)
+						frame.CallVoidMethodA(obj, m_MethodID, v);
+					else
+						frame.CallNonvirtualVoidMethodA(obj, clazz, m_MethodID, v);
+					break;
+			}
+		}
+	}
+
+	if (out == NULL)
+		return;
+
+	// Convert the results
+	for (size_t i = 0; i < results.size(); ++i)
+	{
+		JPPyObject item;
+		if (code == 'V')
+			item = JPPyObject::getNone();
+		else
+		{
+			JPClass *type = retType;
+			if (code == 'L' && results[i].l != NULL)
+				type = frame.findClassForObject(results[i].l);
+			item = type->convertToPythonObject(frame, results[i], false);
+		}
+		PyList_Append(out, item.get());
+	}
+	JP_TRACE_OUT; // GCOVR_EXCL_LINE
+}
+
+#undef JP_CALL_MANY
+
 JPValue JPMethod::invokeConstructor(JPJavaFrame& frame, JPMethodMatch& match, JPPyObjectVector& arg)
 {
 	JP_TRACE_IN("JPMethod::invokeConstructor");
 	size_t alen = m_ParameterTypes.size();
 	vector<jvalue> v(alen + 1);
 	packArgs(frame, match, v, arg);
-	JPPyCallRelease call;
+	JPPyCallRelease call(frame);
 	return JPValue(m_Class, frame.NewObjectA(m_Class->getJavaClass(), m_MethodID, &v[0]));
 	JP_TRACE_OUT;  // GCOVR_EXCL_LINE
 }
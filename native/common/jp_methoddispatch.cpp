@@ -15,9 +15,51 @@
  *****************************************************************************/
 #include <algorithm>
 #include "jpype.h"
+#include "pyjp.h"
 #include "jp_method.h"
 #include "jp_methoddispatch.h"
 
+// Number of calls measured before the adaptive policy decides
+static const int GIL_SAMPLES = 16;
+
+// Mean call time below which the GIL is held (nanoseconds)
+static const jlong GIL_TRIVIAL = 5000;
+
+// Call time above which a held method is considered blocking (nanoseconds)
+static const jlong GIL_BLOCKING = 1000000;
+
+/**
+ * Apply the GIL policy of a dispatch to the calls made through a frame.
+ *
+ * For the adaptive policy JPPyCallRelease times only the Java call itself,
+ * and the time is passed to the dispatch when the call is complete.
+ */
+class JPGILPolicyScope
+{
+public:
+
+	JPGILPolicyScope(JPJavaFrame& frame, JPMethodDispatch* dispatch)
+	: m_Frame(frame), m_Dispatch(dispatch), m_Elapsed(-1)
+	{
+		m_Frame.setReleaseGIL(dispatch->isReleaseGIL());
+		if (dispatch->getGILPolicy() == JPMethodDispatch::_gil_adaptive)
+			m_Frame.setCallTime(&m_Elapsed);
+	}
+
+	~JPGILPolicyScope()
+	{
+		m_Frame.setReleaseGIL(true);
+		m_Frame.setCallTime(NULL);
+		if (m_Elapsed >= 0)
+			m_Dispatch->recordCall(m_Elapsed);
+	}
+
+private:
+	JPJavaFrame& m_Frame;
+	JPMethodDispatch* m_Dispatch;
+	jlong m_Elapsed;
+} ;
+
 JPMethodDispatch::JPMethodDispatch(JPClass* clazz,
 		const string& name,
 		JPMethodList& overloads,
@@ -28,6 +70,26 @@ JPMethodDispatch::JPMethodDispatch(JPClass* clazz,
 	m_Overloads = overloads;
 	m_Modifiers = modifiers;
 	m_LastCache.m_Hash = -1;
+	m_Resolved = true;
+	m_GILPolicy = _gil_release;
+	m_GILHold = false;
+	m_GILSamples = 0;
+	m_GILTime = 0;
+}
+
+JPMethodDispatch::JPMethodDispatch(JPClass* clazz,
+		const string& name,
+		jint modifiers)
+: m_Name(name)
+{
+	m_Class = clazz;
+	m_Modifiers = modifiers;
+	m_LastCache.m_Hash = -1;
+	m_Resolved = false;
+	m_GILPolicy = _gil_release;
+	m_GILHold = false;
+	m_GILSamples = 0;
+	m_GILTime = 0;
 }
 
 JPMethodDispatch::~JPMethodDispatch()
@@ -39,11 +101,61 @@ const string& JPMethodDispatch::getName() const
 	return m_Name;
 }
 
+void JPMethodDispatch::assignOverloads(JPMethodList& overloads)
+{
+	m_Overloads = overloads;
+	m_Resolved = true;
+}
+
+void JPMethodDispatch::setGILPolicy(int policy)
+{
+	m_GILPolicy = policy;
+	m_GILHold = (policy == _gil_hold);
+	m_GILSamples = 0;
+	m_GILTime = 0;
+}
+
+/**
+ * The GIL is held once the first calls are shown to be trivial.  If a held
+ * call then takes long enough to stall other Python threads the GIL is
+ * released for all further calls.
+ */
+void JPMethodDispatch::recordCall(jlong elapsed)
+{
+	if (m_GILSamples < 0)
+		return;
+	if (m_GILHold)
+	{
+		if (elapsed > GIL_BLOCKING)
+		{
+			m_GILHold = false;
+			m_GILSamples = -1;
+		}
+		return;
+	}
+	m_GILTime += elapsed;
+	if (++m_GILSamples < GIL_SAMPLES)
+		return;
+	m_GILHold = (m_GILTime / GIL_SAMPLES) < GIL_TRIVIAL;
+	if (!m_GILHold)
+		m_GILSamples = -1;
+}
+
+void JPMethodDispatch::ensureOverloads()
+{
+	// Overloads are ordered only when the method is first used as
+	// resolving every method of a large class is expensive.
+	if (m_Resolved)
+		return;
+	getContext()->getTypeManager()->populateDispatch(this);
+}
+
 bool JPMethodDispatch::findOverload(JPJavaFrame& frame, JPMethodMatch &bestMatch, JPPyObjectVector& arg,
 		bool callInstance, bool raise)
 {
 	JP_TRACE_IN("JPMethodDispatch::findOverload");
 	JP_TRACE("Checking overload", m_Name);
+	ensureOverloads();
 	JP_TRACE("Got overloads to check", m_Overloads.size());
 	JPMethodList ambiguous;
 
@@ -200,19 +312,116 @@ JPPyObject JPMethodDispatch::invoke(JPJavaFrame& frame, JPPyObjectVector& args,
 	JP_TRACE_IN("JPMethodDispatch::invoke");
 	JPMethodMatch match(frame, args, instance);
 	findOverload(frame, match, args, instance, true);
+	JPGILPolicyScope policy(frame, this);
 	return match.m_Overload->invoke(frame, match, args, instance);
 	JP_TRACE_OUT;
 }
 
+JPPyObject JPMethodDispatch::invokeAsync(JPJavaFrame& frame, JPPyObjectVector& args, bool instance)
+{
+	JP_TRACE_IN("JPMethodDispatch::invokeAsync");
+	JPMethodMatch match(frame, args, instance);
+	findOverload(frame, match, args, instance, true);
+	return match.m_Overload->invokeAsync(frame, match, args);
+	JP_TRACE_OUT;
+}
+
 JPValue JPMethodDispatch::invokeConstructor(JPJavaFrame& frame, JPPyObjectVector& args)
 {
 	JP_TRACE_IN("JPMethodDispatch::invokeConstructor");
 	JPMethodMatch match(frame, args, false);
 	findOverload(frame, match, args, false, true);
+	JPGILPolicyScope policy(frame, this);
 	return match.m_Overload->invokeConstructor(frame, match, args);
 	JP_TRACE_OUT;
 }
 
+JPPyObject JPMethodDispatch::invokeMany(JPJavaFrame& frame, PyObject* self, PyObject* rows)
+{
+	JP_TRACE_IN("JPMethodDispatch::invokeMany");
+	const size_t blockSize = 256;
+	bool instance = self != NULL;
+	bool isVoid = true;
+	ensureOverloads();
+	for (JPMethodList::iterator it = m_Overloads.begin(); it != m_Overloads.end(); ++it)
+	{
+		if ((*it)->getReturnType() != getContext()->_void)
+			isVoid = false;
+	}
+	JPPyObject iter = JPPyObject::call(PyObject_GetIter(rows));
+	JPPyObject out = JPPyObject::call(PyList_New(0));
+
+	bool done = false;
+	while (!done)
+	{
+		// Each block gets its own frame so that the arguments and results
+		// do not accumulate local references.
+		JPJavaFrame block = JPJavaFrame::inner(getContext(), (int) (4 * blockSize));
+		block.setReleaseGIL(isReleaseGIL());
+		vector<vector<jvalue> > calls;
+		JPMethod *current = NULL;
+		while (calls.size() < blockSize)
+		{
+			JPPyObject row = JPPyObject::accept(PyIter_Next(iter.get()));
+			if (row.isNull())
+			{
+				JP_PY_CHECK();
+				done = true;
+				break;
+			}
+			if (!PyTuple_Check(row.get()) && !PyList_Check(row.get()))
+				JP_RAISE(PyExc_TypeError, "map requires an iterable of argument tuples");
+
+			if (instance)
+			{
+				JPPyObjectVector vargs(self, row.get());
+				current = packMany(block, vargs, instance, calls, current, out.get());
+			} else
+			{
+				JPPyObjectVector vargs(row.get());
+				current = packMany(block, vargs, instance, calls, current, out.get());
+			}
+		}
+		if (!calls.empty())
+			current->invokeMany(block, calls, instance, out.get());
+	}
+
+	if (isVoid)
+		return JPPyObject::getNone();
+	return out;
+	JP_TRACE_OUT;
+}
+
+JPMethod* JPMethodDispatch::packMany(JPJavaFrame& frame, JPPyObjectVector& vargs, bool instance,
+		vector<vector<jvalue> >& calls, JPMethod* current, PyObject* out)
+{
+	JPMethodMatch match(frame, vargs, instance);
+
+	// The dispatch cache resolves repeated argument types without
+	// searching the overloads again.
+	findOverload(frame, match, vargs, instance, true);
+	JPMethod *overload = match.m_Overload;
+
+	// Calls to a different overload start a new series.
+	if (current != overload && !calls.empty())
+	{
+		current->invokeMany(frame, calls, instance, out);
+		calls.clear();
+	}
+
+	// Caller sensitive methods must go through the usual path.
+	if (overload->isCallerSensitive())
+	{
+		JPPyObject result = overload->invoke(frame, match, vargs, instance);
+		PyList_Append(out, result.get());
+		return overload;
+	}
+
+	calls.push_back(vector<jvalue>());
+	overload->packCall(frame, match, vargs, calls.back());
+	return overload;
+}
+
 bool JPMethodDispatch::matches(JPJavaFrame& frame, JPPyObjectVector& args, bool instance)
 {
 	JP_TRACE_IN("JPMethodDispatch::invoke");
@@ -223,6 +432,7 @@ bool JPMethodDispatch::matches(JPJavaFrame& frame, JPPyObjectVector& args, bool
 
 string JPMethodDispatch::matchReport(JPPyObjectVector& args)
 {
+	ensureOverloads();
 	stringstream res;
 	res << "Match report for method " << m_Name << ", has " << m_Overloads.size() << " overloads." << endl;
 
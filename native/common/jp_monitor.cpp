@@ -15,6 +15,12 @@
  *****************************************************************************/
 #include "jpype.h"
 #include "jp_monitor.h"
+#include <vector>
+
+// Monitors entered by this thread through Python, innermost last.  Each
+// entry holds its own global reference so that it stays valid if the
+// JPMonitor is freed by another thread while this thread holds the lock.
+static thread_local std::vector<jobject> s_Held;
 
 JPMonitor::JPMonitor(JPContext* context, jobject value) : m_Value(context, value)
 {
@@ -23,20 +29,58 @@ JPMonitor::JPMonitor(JPContext* context, jobject value) : m_Value(context, value
 
 JPMonitor::~JPMonitor()
 {
+	// Entries for a monitor that was not exited are left in place as the
+	// thread which entered it still owns the Java lock.
 }
 
 void JPMonitor::enter()
 {
-	// This can hold off for a while so we need to release resource
-	// so that we don't dead lock.
-	JPPyCallRelease call;
-	JPJavaFrame frame = JPJavaFrame::outer(m_Context);
-	frame.MonitorEnter(m_Value.get());
+	// Entering and leaving a monitor creates no local references, so
+	// a minimal frame is all that is required.
+	JPJavaFrame frame = JPJavaFrame::outer(m_Context, 1);
+	jobject obj = m_Value.get();
+
+	// A monitor that this thread already owns can be entered without
+	// blocking, so there is no need to give up the GIL.  Releasing it
+	// here would force us to compete for the GIL again on the way back.
+	// Monitors held by Java code are not tracked and take the slow path.
+	bool owned = false;
+	for (std::vector<jobject>::reverse_iterator iter = s_Held.rbegin();
+			iter != s_Held.rend(); ++iter)
+	{
+		if (frame.IsSameObject(*iter, obj))
+		{
+			owned = true;
+			break;
+		}
+	}
+
+	if (owned)
+		frame.MonitorEnter(obj);
+	else
+	{
+		// This can hold off for a while so we need to release resource
+		// so that we don't dead lock.
+		JPPyCallRelease call;
+		frame.MonitorEnter(obj);
+	}
+	s_Held.push_back(frame.NewGlobalRef(obj));
 }
 
 void JPMonitor::exit()
 {
-	JPJavaFrame frame = JPJavaFrame::outer(m_Context);
-	frame.MonitorExit(m_Value.get());
+	// Exit never blocks so the GIL is held throughout.
+	JPJavaFrame frame = JPJavaFrame::outer(m_Context, 1);
+	jobject obj = m_Value.get();
+	frame.MonitorExit(obj);
+	for (std::vector<jobject>::reverse_iterator iter = s_Held.rbegin();
+			iter != s_Held.rend(); ++iter)
+	{
+		if (frame.IsSameObject(*iter, obj))
+		{
+			frame.DeleteGlobalRef(*iter);
+			s_Held.erase(--(iter.base()));
+			break;
+		}
+	}
 }
-
@@ -22,23 +22,22 @@
 #include "jp_boxedtype.h"
 #include "jp_functional.h"
 
-JPPyObject getArgs(JPContext* context, jlongArray parameterTypePtrs,
+static JPPyObject getArgs(JPJavaFrame& frame, JPProxyMethod& method,
 		jobjectArray args)
 {
 	JP_TRACE_IN("JProxy::getArgs");
-	JPJavaFrame frame = JPJavaFrame::outer(context);
-	jsize argLen = frame.GetArrayLength(parameterTypePtrs);
+	jsize argLen = (jsize) method.m_ParameterTypes.size();
 	JPPyObject pyargs = JPPyObject::call(PyTuple_New(argLen));
-	JPPrimitiveArrayAccessor<jlongArray, jlong*> accessor(frame, parameterTypePtrs,
-			&JPJavaFrame::GetLongArrayElements, &JPJavaFrame::ReleaseLongArrayElements);
-
-	jlong* types = accessor.get();
 	for (jsize i = 0; i < argLen; i++)
 	{
 		jobject obj = frame.GetObjectArrayElement(args, i);
-		JPClass* type = frame.findClassForObject(obj);
+		JPClass* type = method.m_ArgumentTypes[i];
 		if (type == NULL)
-			type = reinterpret_cast<JPClass*> (types[i]);
+		{
+			type = frame.findClassForObject(obj);
+			if (type == NULL)
+				type = method.m_ParameterTypes[i];
+		}
 		JPValue val = type->getValueFromObject(JPValue(type, obj));
 		PyTuple_SetItem(pyargs.get(), i, type->convertToPythonObject(frame, val, false).keep());
 	}
@@ -48,7 +47,7 @@ JPPyObject getArgs(JPContext* context, jlongArray parameterTypePtrs,
 
 extern "C" JNIEXPORT jobject JNICALL Java_org_jpype_proxy_JPypeProxy_hostInvoke(
 		JNIEnv *env, jclass clazz,
-		jlong contextPtr, jstring name,
+		jlong contextPtr, jstring name, jint index,
 		jlong hostObj,
 		jlong returnTypePtr,
 		jlongArray parameterTypePtrs,
@@ -75,27 +74,17 @@ extern "C" JNIEXPORT jobject JNICALL Java_org_jpype_proxy_JPypeProxy_hostInvoke(
 			}
 			// GCOVR_EXCL_STOP
 
-			string cname = frame.toStringUTF8(name);
-			JP_TRACE("Get callable for", cname);
-
-			// Get the callable object
-			JPPyObject callable(((JPProxy*) hostObj)->getCallable(cname));
-
-			// If method can't be called, throw an exception
-			if (callable.isNull() || callable.get() == Py_None)
-			{
-				JP_TRACE("Callable not found");
-				JP_RAISE_METHOD_NOT_FOUND(cname);
-				return NULL;
-			}
-
-			// Find the return type
-			JPClass* returnClass = (JPClass*) returnTypePtr;
+			// Get the plan for the method
+			JP_TRACE("Get method", index);
+			JPProxyMethod& method = ((JPProxy*) hostObj)->getMethod(frame,
+					index, name, returnTypePtr, parameterTypePtrs);
+			JPClass* returnClass = method.m_ReturnType;
+			JPPyObject callable = JPPyObject::use(method.m_Callable);
 			JP_TRACE("Get return type", returnClass->getCanonicalName());
 
 			// convert the arguments into a python list
 			JP_TRACE("Convert arguments");
-			JPPyObject pyargs = getArgs(context, parameterTypePtrs, args);
+			JPPyObject pyargs = getArgs(frame, method, args);
 
 			JP_TRACE("Call Python");
 			JPPyObject returnValue = JPPyObject::call(PyObject_Call(callable.get(), pyargs.get(), NULL));
@@ -115,28 +104,21 @@ extern "C" JNIEXPORT jobject JNICALL Java_org_jpype_proxy_JPypeProxy_hostInvoke(
 				JP_RAISE(PyExc_TypeError, "Return value is null when it cannot be");
 			}
 
-			// We must box here.
 			JPMatch returnMatch(&frame, returnValue.get());
-			if (returnClass->isPrimitive())
-			{
-				JP_TRACE("Box return");
-				if (returnClass->findJavaConversion(returnMatch) == JPMatch::_none)
-					JP_RAISE(PyExc_TypeError, "Return value is not compatible with required type.");
-				jvalue res = returnMatch.convert();
-				JPBoxedType *boxed =  (JPBoxedType *) ((JPPrimitiveType*) returnClass)->getBoxedClass(context);
-				jvalue res2;
-				res2.l = boxed->box(frame, res);
-				return frame.keep(res2.l);
-			}
-
 			if (returnClass->findJavaConversion(returnMatch) == JPMatch::_none)
 			{
 				JP_TRACE("Cannot convert");
 				JP_RAISE(PyExc_TypeError, "Return value is not compatible with required type.");
 			}
 
-			JP_TRACE("Convert return to", returnClass->getCanonicalName());
+			// We must box here.
 			jvalue res = returnMatch.convert();
+			if (method.m_BoxedReturnType != NULL)
+			{
+				JP_TRACE("Box return");
+				res.l = method.m_BoxedReturnType->box(frame, res);
+			}
+			JP_TRACE("Convert return to", returnClass->getCanonicalName());
 			return frame.keep(res.l);
 		} catch (JPypeException& ex)
 		{
@@ -153,7 +135,199 @@ extern "C" JNIEXPORT jobject JNICALL Java_org_jpype_proxy_JPypeProxy_hostInvoke(
 	}
 }
 
-JPProxy::JPProxy(JPContext* context, PyJPProxy* inst, JPClassList& intf)
+/**
+ * Deliver a batch of calls to a void proxy method.
+ *
+ * The Python method is called once with a list holding the argument tuple
+ * for each call.
+ */
+extern "C" JNIEXPORT void JNICALL Java_org_jpype_proxy_JPypeProxy_hostInvokeBatch(
+		JNIEnv *env, jclass clazz,
+		jlong contextPtr, jstring name, jint index,
+		jlong hostObj,
+		jlong returnTypePtr,
+		jlongArray parameterTypePtrs,
+		jobjectArray calls, jint count)
+{
+	JPContext* context = (JPContext*) contextPtr;
+	JPJavaFrame frame = JPJavaFrame::external(context, env);
+
+	// One GIL acquisition for the whole batch
+	JPPyCallAcquire callback;
+	{
+		JP_TRACE_IN("JPype_InvocationHandler_hostInvokeBatch");
+		try
+		{
+			JPProxyMethod& method = ((JPProxy*) hostObj)->getMethod(frame,
+					index, name, returnTypePtr, parameterTypePtrs);
+			JPPyObject callable = JPPyObject::use(method.m_Callable);
+			JPPyObject pycalls = JPPyObject::call(PyList_New(count));
+			for (jint i = 0; i < count; i++)
+			{
+				JPJavaFrame inner = JPJavaFrame::inner(context);
+				jobjectArray args = (jobjectArray) inner.GetObjectArrayElement(calls, i);
+				PyList_SetItem(pycalls.get(), i, getArgs(inner, method, args).keep());
+			}
+			JPPyObject pyargs = JPPyObject::call(PyTuple_Pack(1, pycalls.get()));
+			JPPyObject::call(PyObject_Call(callable.get(), pyargs.get(), NULL));
+		} catch (JPypeException& ex)
+		{
+			JP_TRACE("JPypeException raised");
+			ex.toJava(context);
+		} catch (...)  // GCOVR_EXCL_LINE
+		{
+			JP_TRACE("Other Exception raised");
+			env->functions->ThrowNew(env, context->m_RuntimeException.get(),
+					"unknown error occurred");
+		}
+		JP_TRACE_OUT;  // GCOVR_EXCL_LINE
+	}
+}
+
+/**
+ * Call a proxy method with unboxed arguments.
+ *
+ * Integral arguments are taken from the long slots, floating point arguments
+ * from the double slots, and objects from the object slot, in order of
+ * appearance.
+ */
+static jvalue hostInvokePrimitive(JNIEnv *env,
+		jlong contextPtr, jstring name, jint index,
+		jlong hostObj,
+		jlong returnTypePtr,
+		jlongArray parameterTypePtrs,
+		jlong j0, jlong j1, jdouble d0, jdouble d1, jobject o0)
+{
+	JPContext* context = (JPContext*) contextPtr;
+	JPJavaFrame frame = JPJavaFrame::external(context, env);
+	jvalue out;
+	out.j = 0;
+
+	// We need the resources to be held for the full duration of the proxy.
+	JPPyCallAcquire callback;
+	{
+		JP_TRACE_IN("JPype_InvocationHandler_hostInvokePrimitive");
+		try
+		{
+			JPProxyMethod& method = ((JPProxy*) hostObj)->getMethod(frame,
+					index, name, returnTypePtr, parameterTypePtrs);
+			JPClass* returnClass = method.m_ReturnType;
+			JPPyObject callable = JPPyObject::use(method.m_Callable);
+
+			// Convert the arguments directly from the slots
+			jlong longs[2] = {j0, j1};
+			jdouble doubles[2] = {d0, d1};
+			int nlong = 0;
+			int ndouble = 0;
+			jsize argLen = (jsize) method.m_ParameterTypes.size();
+			JPPyObject pyargs = JPPyObject::call(PyTuple_New(argLen));
+			for (jsize i = 0; i < argLen; i++)
+			{
+				JPClass* type = method.m_ParameterTypes[i];
+				jvalue v;
+				if (!type->isPrimitive())
+				{
+					v.l = o0;
+					JPClass* exact = method.m_ArgumentTypes[i];
+					if (exact == NULL)
+						exact = frame.findClassForObject(o0);
+					if (exact != NULL)
+						type = exact;
+				} else
+				{
+					switch (((JPPrimitiveType*) type)->getTypeCode())
+					{
+						case 'Z': v.z = (jboolean) longs[nlong++];
+							break;
+						case 'B': v.b = (jbyte) longs[nlong++];
+							break;
+						case 'C': v.c = (jchar) longs[nlong++];
+							break;
+						case 'S': v.s = (jshort) longs[nlong++];
+							break;
+						case 'I': v.i = (jint) longs[nlong++];
+							break;
+						case 'J': v.j = longs[nlong++];
+							break;
+						case 'F': v.f = (jfloat) doubles[ndouble++];
+							break;
+						case 'D': v.d = doubles[ndouble++];
+							break;
+						default: v.j = 0;  // GCOVR_EXCL_LINE
+					}
+				}
+				PyTuple_SetItem(pyargs.get(), i, type->convertToPythonObject(frame, v, false).keep());
+			}
+
+			JPPyObject returnValue = JPPyObject::call(PyObject_Call(callable.get(), pyargs.get(), NULL));
+			if (returnClass == context->_void)
+				return out;
+
+			if (returnValue.isNull())
+				JP_RAISE(PyExc_TypeError, "Return value is null when it cannot be");
+
+			JPMatch returnMatch(&frame, returnValue.get());
+			if (returnClass->findJavaConversion(returnMatch) == JPMatch::_none)
+				JP_RAISE(PyExc_TypeError, "Return value is not compatible with required type.");
+			jvalue res = returnMatch.convert();
+			if (!returnClass->isPrimitive())
+			{
+				out.l = frame.keep(res.l);
+				return out;
+			}
+			JPPrimitiveType *primitive = (JPPrimitiveType*) returnClass;
+			if (primitive->getTypeCode() == 'D' || primitive->getTypeCode() == 'F')
+				out.d = primitive->getAsDouble(res);
+			else
+				out.j = primitive->getAsLong(res);
+			return out;
+		} catch (JPypeException& ex)
+		{
+			JP_TRACE("JPypeException raised");
+			ex.toJava(context);
+		} catch (...)  // GCOVR_EXCL_LINE
+		{
+			JP_TRACE("Other Exception raised");
+			env->functions->ThrowNew(env, context->m_RuntimeException.get(),
+					"unknown error occurred");
+		}
+		return out;
+		JP_TRACE_OUT;  // GCOVR_EXCL_LINE
+	}
+}
+
+extern "C" JNIEXPORT jlong JNICALL Java_org_jpype_proxy_JPypeProxy_hostInvokeLong(
+		JNIEnv *env, jclass clazz,
+		jlong contextPtr, jstring name, jint index,
+		jlong hostObj, jlong returnTypePtr, jlongArray parameterTypePtrs,
+		jlong j0, jlong j1, jdouble d0, jdouble d1, jobject o0)
+{
+	return hostInvokePrimitive(env, contextPtr, name, index, hostObj, returnTypePtr,
+			parameterTypePtrs, j0, j1, d0, d1, o0).j;
+}
+
+extern "C" JNIEXPORT jdouble JNICALL Java_org_jpype_proxy_JPypeProxy_hostInvokeDouble(
+		JNIEnv *env, jclass clazz,
+		jlong contextPtr, jstring name, jint index,
+		jlong hostObj, jlong returnTypePtr, jlongArray parameterTypePtrs,
+		jlong j0, jlong j1, jdouble d0, jdouble d1, jobject o0)
+{
+	return hostInvokePrimitive(env, contextPtr, name, index, hostObj, returnTypePtr,
+			parameterTypePtrs, j0, j1, d0, d1, o0).d;
+}
+
+extern "C" JNIEXPORT jobject JNICALL Java_org_jpype_proxy_JPypeProxy_hostInvokeObject(
+		JNIEnv *env, jclass clazz,
+		jlong contextPtr, jstring name, jint index,
+		jlong hostObj, jlong returnTypePtr, jlongArray parameterTypePtrs,
+		jlong j0, jlong j1, jdouble d0, jdouble d1, jobject o0)
+{
+	return hostInvokePrimitive(env, contextPtr, name, index, hostObj, returnTypePtr,
+			parameterTypePtrs, j0, j1, d0, d1, o0).l;
+}
+
+JPProxy::JPProxy(JPContext* context, PyJPProxy* inst, JPClassList& intf,
+		const JPProxyOptions& options)
 : m_Context(context), m_Instance(inst), m_InterfaceClasses(intf)
 {
 	JP_TRACE_IN("JPProxy::JPProxy");
@@ -167,11 +341,14 @@ JPProxy::JPProxy(JPContext* context, PyJPProxy* inst, JPClassList& intf)
 	{
 		frame.SetObjectArrayElement(ar, i, intf[i]->getJavaClass());
 	}
-	jvalue v[4];
+	jvalue v[7];
 	v[0].l = m_Context->getJavaContext();
 	v[1].j = (jlong) this;
 	v[2].j = (jlong) & JPProxy::releaseProxyPython;
 	v[3].l = ar;
+	v[4].z = options.m_Asynchronous;
+	v[5].i = options.m_BatchSize;
+	v[6].j = options.m_BatchLatency;
 
 	// Create the proxy
 	jobject proxy = frame.CallStaticObjectMethodA(context->m_ProxyClass.get(),
@@ -183,6 +360,9 @@ JPProxy::JPProxy(JPContext* context, PyJPProxy* inst, JPClassList& intf)
 
 JPProxy::~JPProxy()
 {
+	clearCallables();
+	for (size_t i = 0; i < m_Methods.size(); ++i)
+		delete m_Methods[i];
 	try
 	{
 		if (m_Ref != NULL && m_Context->isRunning())
@@ -195,6 +375,91 @@ JPProxy::~JPProxy()
 	}
 }
 
+JPProxyMethod& JPProxy::getMethod(JPJavaFrame& frame, jint index, jstring name,
+		jlong returnType, jlongArray parameterTypes)
+{
+	if (index < (jint) m_Methods.size() && m_Methods[index] != NULL
+			&& m_Methods[index]->m_Callable != NULL)
+		return *m_Methods[index];
+
+	JP_TRACE_IN("JPProxy::getMethod");
+	string cname = frame.toStringUTF8(name);
+	JP_TRACE("Get callable for", cname);
+	JPPyObject callable = getCallable(cname);
+
+	// If method can't be called, throw an exception
+	if (callable.isNull() || callable.get() == Py_None)
+	{
+		JP_TRACE("Callable not found");
+		JP_RAISE_METHOD_NOT_FOUND(cname);
+	}
+
+	// The conversions never change, so a plan whose callable was cleared
+	// only needs the callable replaced.
+	if (index < (jint) m_Methods.size() && m_Methods[index] != NULL)
+	{
+		JPProxyMethod *method = m_Methods[index];
+		Py_XDECREF(method->m_Callable);
+		method->m_Callable = callable.keep();
+		return *method;
+	}
+
+	// Decide how the return will be converted
+	JPProxyMethod *method = new JPProxyMethod();
+	method->m_ReturnType = (JPClass*) returnType;
+	if (method->m_ReturnType != m_Context->_void && method->m_ReturnType->isPrimitive())
+		method->m_BoxedReturnType = (JPBoxedType*) ((JPPrimitiveType*) method->m_ReturnType)->getBoxedClass(m_Context);
+
+	// Decide how each argument will be converted
+	jsize argLen = frame.GetArrayLength(parameterTypes);
+	JPPrimitiveArrayAccessor<jlongArray, jlong*> accessor(frame, parameterTypes,
+			&JPJavaFrame::GetLongArrayElements, &JPJavaFrame::ReleaseLongArrayElements);
+	jlong* types = accessor.get();
+	for (jsize i = 0; i < argLen; i++)
+	{
+		JPClass *type = reinterpret_cast<JPClass*> (types[i]);
+		JPClass *exact = NULL;
+		if (type->isPrimitive())
+		{
+			// Primitives always arrive in their box
+			exact = ((JPPrimitiveType*) type)->getBoxedClass(m_Context);
+		} else if (type->isFinal() && !type->isArray())
+		{
+			// Final classes can only hold one type
+			exact = type;
+		}
+		method->m_ParameterTypes.push_back(type);
+		method->m_ArgumentTypes.push_back(exact);
+	}
+
+	// Hold the plan for the next time this method is called
+	if (index >= (jint) m_Methods.size())
+		m_Methods.resize(index + 1, NULL);
+	method->m_Callable = callable.keep();
+	m_Methods[index] = method;
+	return *method;
+	JP_TRACE_OUT;  // GCOVR_EXCL_LINE
+}
+
+int JPProxy::traverseCallables(visitproc visit, void *arg)
+{
+	for (size_t i = 0; i < m_Methods.size(); ++i)
+	{
+		if (m_Methods[i] != NULL)
+			Py_VISIT(m_Methods[i]->m_Callable);
+	}
+	return 0;
+}
+
+void JPProxy::clearCallables()
+{
+	for (size_t i = 0; i < m_Methods.size(); ++i)
+	{
+		if (m_Methods[i] != NULL)
+			Py_CLEAR(m_Methods[i]->m_Callable);
+	}
+}
+
 void JPProxy::releaseProxyPython(void* host)
 {
 	Py_XDECREF(((JPProxy*) host)->m_Instance);
@@ -235,10 +500,9 @@ JPProxyType::JPProxyType(JPJavaFrame& frame,
 		jint modifiers)
 : JPClass(frame, clss, name, super, interfaces, modifiers)
 {
-	jclass proxyClass = frame.FindClass("java/lang/reflect/Proxy");
-	m_ProxyClass = JPClassRef(frame, proxyClass);
-	m_GetInvocationHandlerID = frame.GetStaticMethodID(proxyClass, "getInvocationHandler",
-			"(Ljava/lang/Object;)Ljava/lang/reflect/InvocationHandler;");
+	m_ProxyClass = JPClassRef(frame, clss);
+	m_GetInvocationHandlerID = frame.GetStaticMethodID(clss, "getHandler",
+			"(Ljava/lang/Object;)Lorg/jpype/proxy/JPypeProxy;");
 	m_InstanceID = frame.GetFieldID(clss, "instance", "J");
 }
 
@@ -259,8 +523,9 @@ JPPyObject JPProxyType::convertToPythonObject(JPJavaFrame& frame, jvalue val, bo
 	JP_TRACE_OUT;  // GCOVR_EXCL_LINE
 }
 
-JPProxyDirect::JPProxyDirect(JPContext* context, PyJPProxy* inst, JPClassList& intf)
-: JPProxy(context, inst, intf)
+JPProxyDirect::JPProxyDirect(JPContext* context, PyJPProxy* inst, JPClassList& intf,
+		const JPProxyOptions& options)
+: JPProxy(context, inst, intf, options)
 {
 }
 
@@ -273,8 +538,9 @@ JPPyObject JPProxyDirect::getCallable(const string& cname)
 	return JPPyObject::accept(PyObject_GetAttrString((PyObject*) m_Instance, cname.c_str()));
 }
 
-JPProxyIndirect::JPProxyIndirect(JPContext* context, PyJPProxy* inst, JPClassList& intf)
-: JPProxy(context, inst, intf)
+JPProxyIndirect::JPProxyIndirect(JPContext* context, PyJPProxy* inst, JPClassList& intf,
+		const JPProxyOptions& options)
+: JPProxy(context, inst, intf, options)
 {
 }
 
@@ -291,7 +557,7 @@ JPPyObject JPProxyIndirect::getCallable(const string& cname)
 }
 
 JPProxyFunctional::JPProxyFunctional(JPContext* context, PyJPProxy* inst, JPClassList& intf)
-: JPProxy(context, inst, intf)
+: JPProxy(context, inst, intf, JPProxyOptions())
 {
 	m_Functional = (JPFunctional*) intf[0];
 }
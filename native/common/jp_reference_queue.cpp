@@ -20,9 +20,26 @@
 #include "jp_reference_queue.h"
 #include "jp_gc.h"
 #include "pyjp.h"
+#include "jp_primitive_accessor.h"
+#include <chrono>
 
 static jobject s_ReferenceQueue = NULL;
 static jmethodID s_ReferenceQueueRegisterMethod = NULL;
+static jmethodID s_ReferenceQueueRegisterBatchMethod = NULL;
+
+// Registrations are staged here and sent to Java in a single call.  The
+// Java object is held with a global reference while it is staged so that
+// it cannot be collected before the phantom reference is created.  Access
+// is protected by the GIL as is required to manipulate the host reference.
+// The batch is sent when it is full or when the oldest entry is older than
+// the age limit and a registration or an outer frame gives us the chance.
+static const int REFERENCE_BATCH_SIZE = 256;
+static const std::chrono::milliseconds REFERENCE_MAX_AGE(50);
+static jobject s_PendingObjects[REFERENCE_BATCH_SIZE];
+static jlong s_PendingHosts[REFERENCE_BATCH_SIZE];
+static jlong s_PendingCleanups[REFERENCE_BATCH_SIZE];
+static int s_PendingCount = 0;
+static std::chrono::steady_clock::time_point s_PendingSince;
 
 extern "C"
 {
@@ -35,13 +52,14 @@ static void releasePython(void* host)
 /*
  * Class:     org_jpype_ref_JPypeReferenceQueue
  * Method:    init
- * Signature: (Ljava/lang/Object;Ljava/lang/reflect/Method;)V
+ * Signature: (Ljava/lang/Object;Ljava/lang/reflect/Method;Ljava/lang/reflect/Method;)V
  */
 JNIEXPORT void JNICALL Java_org_jpype_ref_JPypeReferenceNative_init
-(JNIEnv *env, jclass clazz, jobject refqueue, jobject registerID)
+(JNIEnv *env, jclass clazz, jobject refqueue, jobject registerID, jobject registerBatchID)
 {
 	s_ReferenceQueue = env->NewGlobalRef(refqueue);
 	s_ReferenceQueueRegisterMethod = env->FromReflectedMethod(registerID);
+	s_ReferenceQueueRegisterBatchMethod = env->FromReflectedMethod(registerBatchID);
 }
 
 JNIEXPORT void JNICALL Java_org_jpype_ref_JPypeReferenceNative_removeHostReference
@@ -63,6 +81,35 @@ JNIEXPORT void JNICALL Java_org_jpype_ref_JPypeReferenceNative_removeHostReferen
 	}
 }
 
+JNIEXPORT void JNICALL Java_org_jpype_ref_JPypeReferenceNative_removeHostReferences
+(JNIEnv *env, jclass, jlongArray hosts, jlongArray cleanups, jint count)
+{
+	JPContext* context = JPContext_global;
+	// Exceptions are not allowed here
+	try
+	{
+		JPJavaFrame frame = JPJavaFrame::external((JPContext*) context, env);
+		JPPrimitiveArrayAccessor<jlongArray, jlong*> hostAccessor(frame, hosts,
+				&JPJavaFrame::GetLongArrayElements, &JPJavaFrame::ReleaseLongArrayElements);
+		JPPrimitiveArrayAccessor<jlongArray, jlong*> cleanupAccessor(frame, cleanups,
+				&JPJavaFrame::GetLongArrayElements, &JPJavaFrame::ReleaseLongArrayElements);
+		jlong *hostPtr = hostAccessor.get();
+		jlong *cleanupPtr = cleanupAccessor.get();
+
+		// Acquire the GIL once for the whole batch
+		JPPyCallAcquire callback;
+		for (jint i = 0; i < count; ++i)
+		{
+			if (cleanupPtr[i] == 0)
+				continue;
+			JCleanupHook func = (JCleanupHook) cleanupPtr[i];
+			(*func)((void*) hostPtr[i]);
+		}
+	} catch (...) // GCOVR_EXCL_LINE
+	{
+	}
+}
+
 /** Triggered whenever the sentinel is deleted
  */
 JNIEXPORT void JNICALL Java_org_jpype_ref_JPypeReferenceNative_wake
@@ -96,16 +143,107 @@ void JPReferenceQueue::registerRef(JPJavaFrame &frame, jobject obj, PyObject* ho
 void JPReferenceQueue::registerRef(JPJavaFrame &frame, jobject obj, void* host, JCleanupHook func)
 {
 	JP_TRACE_IN("JPReferenceQueue::registerRef");
-
-	// create the ref ...
-	jvalue args[3];
-	args[0].l = obj;
-	args[1].j = (jlong) host;
-	args[2].j = (jlong) func;
-
 	if (s_ReferenceQueue == NULL)
 		JP_RAISE(PyExc_SystemError, "Memory queue not installed");
-	JP_TRACE("Register reference");
-	frame.CallVoidMethodA(s_ReferenceQueue, s_ReferenceQueueRegisterMethod, args);
+
+	// Before the batch method is available we must go directly to Java.
+	if (s_ReferenceQueueRegisterBatchMethod == NULL)
+	{
+		jvalue args[3];
+		args[0].l = obj;
+		args[1].j = (jlong) host;
+		args[2].j = (jlong) func;
+		JP_TRACE("Register reference");
+		frame.CallVoidMethodA(s_ReferenceQueue, s_ReferenceQueueRegisterMethod, args);
+		return;
+	}
+
+	// Stage the reference
+	JP_TRACE("Stage reference", s_PendingCount);
+	if (s_PendingCount == 0)
+		s_PendingSince = std::chrono::steady_clock::now();
+	s_PendingObjects[s_PendingCount] = frame.NewGlobalRef(obj);
+	s_PendingHosts[s_PendingCount] = (jlong) host;
+	s_PendingCleanups[s_PendingCount] = (jlong) func;
+	s_PendingCount++;
+	if (s_PendingCount == REFERENCE_BATCH_SIZE)
+		flush(frame);
+	else
+		flushAged(frame);
+	JP_TRACE_OUT; // GCOVR_EXCL_LINE
+}
+
+static void releasePending(JPJavaFrame &frame, jsize count)
+{
+	for (jsize i = 0; i < count; ++i)
+	{
+		if (s_PendingObjects[i] == NULL)
+			continue;
+		frame.DeleteGlobalRef(s_PendingObjects[i]);
+		s_PendingObjects[i] = NULL;
+	}
+}
+
+bool JPReferenceQueue::hasPending()
+{
+	return s_PendingCount > 0;
+}
+
+void JPReferenceQueue::flushAged(JPJavaFrame &frame)
+{
+	if (s_PendingCount == 0)
+		return;
+	if (std::chrono::steady_clock::now() - s_PendingSince < REFERENCE_MAX_AGE)
+		return;
+	flush(frame);
+}
+
+void JPReferenceQueue::flush(JPJavaFrame &frame)
+{
+	JP_TRACE_IN("JPReferenceQueue::flush");
+	if (s_PendingCount == 0)
+		return;
+	JP_TRACE("Flush references", s_PendingCount);
+
+	// Remove the staged items first so that a failure cannot cause them
+	// to be registered twice.
+	jsize count = s_PendingCount;
+	s_PendingCount = 0;
+
+	// We may be called while an exception is being thrown to Java so
+	// hold it until the registration is complete.
+	jthrowable th = frame.ExceptionOccurred();
+	if (th != NULL)
+		frame.ExceptionClear();
+
+	// The global references must be released even if the registration
+	// fails.  The hosts are not released on failure as the Java objects
+	// may still refer to them; they are leaked rather than freed early.
+	try
+	{
+		JPContext *context = frame.getContext();
+		jobjectArray objects = frame.NewObjectArray(count,
+				context->_java_lang_Object->getJavaClass(), NULL);
+		for (jsize i = 0; i < count; ++i)
+			frame.SetObjectArrayElement(objects, i, s_PendingObjects[i]);
+		jlongArray hosts = frame.NewLongArray(count);
+		frame.SetLongArrayRegion(hosts, 0, count, s_PendingHosts);
+		jlongArray cleanups = frame.NewLongArray(count);
+		frame.SetLongArrayRegion(cleanups, 0, count, s_PendingCleanups);
+		releasePending(frame, count);
+
+		jvalue args[3];
+		args[0].l = objects;
+		args[1].l = hosts;
+		args[2].l = cleanups;
+		frame.CallVoidMethodA(s_ReferenceQueue, s_ReferenceQueueRegisterBatchMethod, args);
+	} catch (...)
+	{
+		releasePending(frame, count);
+		throw;
+	}
+
+	if (th != NULL)
+		frame.Throw(th);
 	JP_TRACE_OUT; // GCOVR_EXCL_LINE
 }
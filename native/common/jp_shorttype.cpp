@@ -148,7 +148,7 @@ JPPyObject JPShortType::invokeStatic(JPJavaFrame& frame, jclass claz, jmethodID
 {
 	jvalue v;
 	{
-		JPPyCallRelease call;
+		JPPyCallRelease call(frame);
 		field(v) = frame.CallStaticShortMethodA(claz, mth, val);
 	}
 	return convertToPythonObject(frame, v, false);
@@ -158,7 +158,7 @@ JPPyObject JPShortType::invoke(JPJavaFrame& frame, jobject obj, jclass clazz, jm
 {
 	jvalue v;
 	{
-		JPPyCallRelease call;
+		JPPyCallRelease call(frame);
 		if (clazz == NULL)
 			field(v) = frame.CallShortMethodA(obj, mth, val);
 		else
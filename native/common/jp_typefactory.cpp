@@ -130,15 +130,31 @@ JNIEXPORT jlong JNICALL Java_org_jpype_manager_TypeFactoryNative_defineMethodDis
 	JPJavaFrame frame = JPJavaFrame::external(context, env);
 	JP_JAVA_TRY("JPTypeFactory_defineMethodDispatch");
 	JPClass* cls = (JPClass*) clsPtr;
-	JPMethodList overloadList;
-	convert(frame, overloadPtrs, overloadList);
 	string cname = frame.toStringUTF8(name);
 	JP_TRACE(cname);
+	if (overloadPtrs == NULL)
+		return (jlong) new JPMethodDispatch(cls, cname, modifiers);
+	JPMethodList overloadList;
+	convert(frame, overloadPtrs, overloadList);
 	JPMethodDispatch* dispatch = new JPMethodDispatch(cls, cname, overloadList, modifiers);
 	return (jlong) dispatch;
 	JP_JAVA_CATCH(0);  // GCOVR_EXCL_LINE
 }
 
+JNIEXPORT void JNICALL Java_org_jpype_manager_TypeFactoryNative_assignOverloads(
+		JNIEnv *env, jobject self, jlong contextPtr,
+		jlong dispatchPtr,
+		jlongArray overloadPtrs)
+{
+	JPContext* context = (JPContext*) contextPtr;
+	JPJavaFrame frame = JPJavaFrame::external(context, env);
+	JP_JAVA_TRY("JPTypeFactory_assignOverloads");
+	JPMethodList overloadList;
+	convert(frame, overloadPtrs, overloadList);
+	((JPMethodDispatch*) dispatchPtr)->assignOverloads(overloadList);
+	JP_JAVA_CATCH();  // GCOVR_EXCL_LINE
+}
+
 JNIEXPORT jlong JNICALL Java_org_jpype_manager_TypeFactoryNative_defineArrayClass(
 		JNIEnv *env, jobject self, jlong contextPtr,
 		jclass cls,
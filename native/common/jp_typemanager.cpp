@@ -15,11 +15,13 @@
  *****************************************************************************/
 #include "jpype.h"
 #include "jp_classloader.h"
+#include "jp_methoddispatch.h"
 
 JPTypeManager::JPTypeManager(JPJavaFrame& frame)
 {
 	JP_TRACE_IN("JPTypeManager::init");
 	m_Context = frame.getContext();
+	m_ThrowableCacheSize = 0;
 
 	jclass cls = m_Context->getClassLoader()->findClass(frame, "org.jpype.manager.TypeManager");
 	m_FindClass = frame.GetMethodID(cls, "findClass", "(Ljava/lang/Class;)J");
@@ -27,6 +29,7 @@ JPTypeManager::JPTypeManager(JPJavaFrame& frame)
 	m_FindClassForObject = frame.GetMethodID(cls, "findClassForObject", "(Ljava/lang/Object;)J");
 	m_PopulateMethod = frame.GetMethodID(cls, "populateMethod", "(JLjava/lang/reflect/Executable;)V");
 	m_PopulateMembers = frame.GetMethodID(cls, "populateMembers", "(Ljava/lang/Class;)V");
+	m_PopulateDispatch = frame.GetMethodID(cls, "populateDispatch", "(Ljava/lang/Class;Ljava/lang/String;)V");
 
 	// The object instance will be loaded later
 	JP_TRACE_OUT;
@@ -76,6 +79,55 @@ JPClass* JPTypeManager::findClassForObject(jobject obj)
 	JP_TRACE_OUT;
 }
 
+JPClass* JPTypeManager::findCachedThrowable(JPJavaFrame& frame, jthrowable th)
+{
+	JP_TRACE_IN("JPTypeManager::findCachedThrowable");
+	if (m_ThrowableCacheSize == 0)
+		return NULL;
+	jclass objClass = frame.GetObjectClass((jobject) th);
+	for (int i = 0; i < m_ThrowableCacheSize; ++i)
+	{
+		JPClass *cls = m_ThrowableCache[i];
+		if (!frame.IsSameObject((jobject) cls->getJavaClass(), (jobject) objClass))
+			continue;
+		// Move to the front so the common exceptions are found first
+		for (; i > 0; --i)
+			m_ThrowableCache[i] = m_ThrowableCache[i - 1];
+		m_ThrowableCache[0] = cls;
+		return cls;
+	}
+	return NULL;
+	JP_TRACE_OUT;
+}
+
+JPClass* JPTypeManager::findClassForThrowable(JPJavaFrame& frame, jthrowable th)
+{
+	JP_TRACE_IN("JPTypeManager::findClassForThrowable");
+	JPClass *cls = findCachedThrowable(frame, th);
+	if (cls != NULL)
+		return cls;
+	cls = findClassForObject((jobject) th);
+	if (cls == NULL || cls->getCanonicalName() == "org.jpype.PyExceptionProxy")
+		return cls;
+
+	// Anonymous classes share a wrapper which holds the parent class, so
+	// the wrapper cannot be matched to the class of the exception.
+	if (JPModifier::isAnonymous(cls->getModifiers()))
+		return cls;
+
+	// Replace the least recently used entry
+	int n = m_ThrowableCacheSize;
+	if (n == THROWABLE_CACHE_SIZE)
+		n--;
+	else
+		m_ThrowableCacheSize++;
+	for (; n > 0; --n)
+		m_ThrowableCache[n] = m_ThrowableCache[n - 1];
+	m_ThrowableCache[0] = cls;
+	return cls;
+	JP_TRACE_OUT;
+}
+
 void JPTypeManager::populateMethod(void* method, jobject obj)
 {
 	JP_TRACE_IN("JPTypeManager::populateMethod");
@@ -97,3 +149,14 @@ void JPTypeManager::populateMembers(JPClass* cls)
 	frame.CallVoidMethodA(m_JavaTypeManager.get(), m_PopulateMembers, val);
 	JP_TRACE_OUT;
 }
+
+void JPTypeManager::populateDispatch(JPMethodDispatch* dispatch)
+{
+	JP_TRACE_IN("JPTypeManager::populateDispatch");
+	JPJavaFrame frame = JPJavaFrame::outer(m_Context);
+	jvalue val[2];
+	val[0].l = (jobject) dispatch->getClass()->getJavaClass();
+	val[1].l = (jobject) frame.fromStringUTF8(dispatch->getName());
+	frame.CallVoidMethodA(m_JavaTypeManager.get(), m_PopulateDispatch, val);
+	JP_TRACE_OUT;
+}
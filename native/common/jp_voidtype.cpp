@@ -28,7 +28,7 @@ JPVoidType::~JPVoidType()
 JPPyObject JPVoidType::invokeStatic(JPJavaFrame& frame, jclass claz, jmethodID mth, jvalue* val)
 {
 	{
-		JPPyCallRelease call;
+		JPPyCallRelease call(frame);
 		frame.CallStaticVoidMethodA(claz, mth, val);
 	}
 	return JPPyObject::getNone();
@@ -37,7 +37,7 @@ JPPyObject JPVoidType::invokeStatic(JPJavaFrame& frame, jclass claz, jmethodID m
 JPPyObject JPVoidType::invoke(JPJavaFrame& frame, jobject obj, jclass clazz, jmethodID mth, jvalue* val)
 {
 	{
-		JPPyCallRelease call;
+		JPPyCallRelease call(frame);
 		if (clazz == NULL)
 			frame.CallVoidMethodA(obj, mth, val);
 		else
@@ -29,6 +29,10 @@ import java.util.ArrayList;
 import java.util.Arrays;
 import java.util.List;
 import java.util.Map;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.ThreadFactory;
 import java.util.concurrent.atomic.AtomicInteger;
 import org.jpype.classloader.DynamicClassLoader;
 import org.jpype.manager.TypeFactory;
@@ -344,6 +348,67 @@ public class JPypeContext
     }
   }
 
+  private static ExecutorService asyncExecutor;
+
+  /**
+   * Get the executor for asynchronous method calls.
+   */
+  static synchronized ExecutorService getAsyncExecutor()
+  {
+    if (asyncExecutor == null)
+    {
+      asyncExecutor = Executors.newCachedThreadPool(new ThreadFactory()
+      {
+        final AtomicInteger count = new AtomicInteger();
+
+        @Override
+        public Thread newThread(Runnable r)
+        {
+          Thread thread = new Thread(r, "JPype-Async-" + count.incrementAndGet());
+          thread.setDaemon(true);
+          return thread;
+        }
+      });
+    }
+    return asyncExecutor;
+  }
+
+  /**
+   * Call a method using reflection on a Java thread.
+   * <p>
+   * The arguments have already been converted so the call does not need
+   * Python until the result is delivered.
+   *
+   * @param method is the method to call.
+   * @param obj is the object to operate on, it will be null if the method is
+   * static.
+   * @param args the arguments to method.
+   * @return a future which completes with the result of the call.
+   */
+  public CompletableFuture<Object> callMethodAsync(final Method method,
+          final Object obj, final Object[] args)
+  {
+    final CompletableFuture<Object> future = new CompletableFuture<>();
+    getAsyncExecutor().execute(new Runnable()
+    {
+      @Override
+      public void run()
+      {
+        try
+        {
+          future.complete(method.invoke(obj, args));
+        } catch (InvocationTargetException ex)
+        {
+          future.completeExceptionally(ex.getCause());
+        } catch (Throwable th)
+        {
+          future.completeExceptionally(th);
+        }
+      }
+    });
+    return future;
+  }
+
   /**
    * Helper function for collect rectangular,
    */
@@ -647,10 +712,12 @@ public class JPypeContext
   {
     // Scan existing jars for missing directory entries
     String[] paths = System.getProperty("java.class.path").split(File.pathSeparator);
+    List<Path> jars = new ArrayList<>(paths.length);
     for (String path : paths)
     {
-      INSTANCE.classLoader.scanJar(Paths.get(path));
+      jars.add(Paths.get(path));
     }
+    INSTANCE.classLoader.scanJars(jars);
   }
 
 }
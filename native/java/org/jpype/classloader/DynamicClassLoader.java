@@ -17,20 +17,30 @@ import java.nio.file.PathMatcher;
 import java.nio.file.SimpleFileVisitor;
 import java.nio.file.attribute.BasicFileAttributes;
 import java.util.ArrayList;
+import java.util.Arrays;
 import java.util.Collections;
 import java.util.Enumeration;
 import java.util.HashMap;
 import java.util.LinkedList;
 import java.util.List;
 import java.util.Set;
+import java.util.concurrent.Callable;
+import java.util.concurrent.ExecutionException;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.Future;
+import java.util.concurrent.ThreadFactory;
 import java.util.jar.JarEntry;
 import java.util.jar.JarFile;
 
 public class DynamicClassLoader extends ClassLoader
 {
 
+  static final int MAX_SCAN_THREADS = 8;
   List<URLClassLoader> loaders = new LinkedList<>();
   HashMap<String, ArrayList<URL>> map = new HashMap<>();
+  // Read by JPype to forget the names not found in a package.
+  volatile int generation = 0;
 
   public DynamicClassLoader(ClassLoader parent)
   {
@@ -42,6 +52,26 @@ public class DynamicClassLoader extends ClassLoader
     return loaders.hashCode();
   }
 
+  /**
+   * Get the number of times the class path has changed.
+   *
+   * @return the current generation.
+   */
+  public int getGeneration()
+  {
+    return generation;
+  }
+
+  /**
+   * Get the loaders for the jars added to the classpath.
+   *
+   * @return the list of loaders in the order they were added.
+   */
+  public List<URLClassLoader> getLoaders()
+  {
+    return Collections.unmodifiableList(loaders);
+  }
+
   /**
    * Add a set of jars to the classpath.
    *
@@ -54,6 +84,7 @@ public class DynamicClassLoader extends ClassLoader
     final PathMatcher pathMatcher = FileSystems.getDefault().getPathMatcher(glob);
 
     List<URL> urls = new LinkedList<>();
+    List<Path> paths = new ArrayList<>();
     Files.walkFileTree(root, new SimpleFileVisitor<Path>()
     {
 
@@ -65,6 +96,7 @@ public class DynamicClassLoader extends ClassLoader
         {
           URL url = path.toUri().toURL();
           urls.add(url);
+          paths.add(path);
         }
         return FileVisitResult.CONTINUE;
       }
@@ -78,6 +110,40 @@ public class DynamicClassLoader extends ClassLoader
     });
 
     loaders.add(new URLClassLoader(urls.toArray(new URL[urls.size()])));
+    this.scanJars(paths);
+    generation++;
+  }
+
+  /**
+   * Add a list of jars to the classpath.
+   * <p>
+   * This is used when a glob is expanded so that the jars can be scanned
+   * together.
+   *
+   * @param paths is the list of jars in the order to search them.
+   * @throws FileNotFoundException if any of the jars is missing.
+   */
+  public void addFiles(Path[] paths) throws FileNotFoundException
+  {
+    try
+    {
+      URL[] urls = new URL[paths.length];
+      for (int i = 0; i < paths.length; ++i)
+      {
+        if (!Files.exists(paths[i]))
+          throw new FileNotFoundException(paths[i].toString());
+        urls[i] = paths[i].toUri().toURL();
+      }
+      loaders.add(new URLClassLoader(urls));
+
+      // Scan the files for directory entries
+      this.scanJars(Arrays.asList(paths));
+      generation++;
+    } catch (MalformedURLException ex)
+    {
+      // This should never happen
+      throw new RuntimeException(ex);
+    }
   }
 
   public void addFile(Path path) throws FileNotFoundException
@@ -94,6 +160,7 @@ public class DynamicClassLoader extends ClassLoader
 
       // Scan the file for directory entries
       this.scanJar(path);
+      generation++;
     } catch (MalformedURLException ex)
     {
       // This should never happen
@@ -184,6 +251,7 @@ public class DynamicClassLoader extends ClassLoader
     if (!this.map.containsKey(name))
       this.map.put(name, new ArrayList<>());
     this.map.get(name).add(url);
+    generation++;
   }
 
   /**
@@ -197,15 +265,92 @@ public class DynamicClassLoader extends ClassLoader
    */
   public void scanJar(Path p1)
   {
-    if (!Files.exists(p1))
+    addMissing(p1, listMissing(p1));
+  }
+
+  /**
+   * Recreate missing directory entries for a list of jars.
+   *
+   * Reading the directory of each jar is dominated by I/O so the jars are
+   * read on a bounded pool of threads. The results are merged in the order
+   * given so the resources are the same as scanning one jar at a time.
+   *
+   * @param paths is the list of jars to scan.
+   */
+  public void scanJars(List<Path> paths)
+  {
+    int threads = Math.min(paths.size(),
+            Math.min(MAX_SCAN_THREADS, Runtime.getRuntime().availableProcessors()));
+    if (threads <= 1)
+    {
+      for (Path path : paths)
+      {
+        scanJar(path);
+      }
       return;
+    }
+
+    ExecutorService executor = Executors.newFixedThreadPool(threads, new ThreadFactory()
+    {
+      @Override
+      public Thread newThread(Runnable r)
+      {
+        Thread thread = new Thread(r, "JPype-ScanJar");
+        thread.setDaemon(true);
+        return thread;
+      }
+    });
+    try
+    {
+      List<Future<List<String>>> results = new ArrayList<>(paths.size());
+      for (final Path path : paths)
+      {
+        results.add(executor.submit(new Callable<List<String>>()
+        {
+          @Override
+          public List<String> call()
+          {
+            return listMissing(path);
+          }
+        }));
+      }
+      for (int i = 0; i < paths.size(); ++i)
+      {
+        try
+        {
+          addMissing(paths.get(i), results.get(i).get());
+        } catch (ExecutionException ex)
+        {
+          // Anything goes wrong skip it
+        }
+      }
+    } catch (InterruptedException ex)
+    {
+      Thread.currentThread().interrupt();
+    } finally
+    {
+      executor.shutdownNow();
+    }
+  }
+
+  /**
+   * Find the directories missing from a jar.
+   *
+   * @param p1 is the jar to scan.
+   * @return the list of directories without an entry, or an empty list if
+   * the jar has directory entries.
+   */
+  static List<String> listMissing(Path p1)
+  {
+    List<String> out = new ArrayList<>();
+    if (!Files.exists(p1))
+      return out;
     if (Files.isDirectory(p1))
-      return;
+      return out;
     try ( JarFile jf = new JarFile(p1.toFile()))
     {
       Enumeration<JarEntry> entries = jf.entries();
-      URI abs = p1.toAbsolutePath().toUri();
-      Set urls = new java.util.HashSet();
+      Set<String> urls = new java.util.HashSet<>();
       while (entries.hasMoreElements())
       {
         JarEntry next = entries.nextElement();
@@ -218,7 +363,7 @@ public class DynamicClassLoader extends ClassLoader
         if (next.isDirectory())
         {
           // If we find a directory entry then the jar has directories already
-          return;
+          return Collections.emptyList();
         }
 
         // Split on each separator in the name
@@ -237,12 +382,31 @@ public class DynamicClassLoader extends ClassLoader
             continue;
 
           // Add a new entry for the missing directory
-          String jar = "jar:" + abs + "!/" + name2 + "/";
           urls.add(name2);
-          this.addResource(name2, new URL(jar));
+          out.add(name2);
         }
       }
     } catch (IOException ex)
+    {
+      // Anything goes wrong skip it
+      return Collections.emptyList();
+    }
+    return out;
+  }
+
+  private void addMissing(Path p1, List<String> missing)
+  {
+    if (missing.isEmpty())
+      return;
+    try
+    {
+      URI abs = p1.toAbsolutePath().toUri();
+      for (String name : missing)
+      {
+        String jar = "jar:" + abs + "!/" + name + "/";
+        this.addResource(name, new URL(jar));
+      }
+    } catch (MalformedURLException ex)
     {
       // Anything goes wrong skip it
     }
@@ -17,6 +17,8 @@ package org.jpype.manager;
 
 import java.lang.reflect.Executable;
 import java.lang.reflect.Method;
+import java.util.HashMap;
+import java.util.List;
 
 /**
  * A list of resources associated with this class.
@@ -45,7 +47,36 @@ public class ClassDescriptor
   public long[] methods;
   public int methodCounter = 0;
   public long[] fields;
-  public long anonymous;
+  /**
+   * Wrapper shared by anonymous classes which extend this class.
+   */
+  public ClassDescriptor anonymous;
+  /**
+   * Method dispatches which have not yet been resolved.
+   */
+  public HashMap<String, Pending> pending;
+  /**
+   * Member counts used to match the class in the snapshot.
+   */
+  int methodCount = -1;
+  int constructorCount;
+
+  /**
+   * A method dispatch waiting for its overloads.
+   */
+  static class Pending
+  {
+
+    long dispatch;
+    List<Method> methods;
+    boolean attempted;
+
+    Pending(long dispatch, List<Method> methods)
+    {
+      this.dispatch = dispatch;
+      this.methods = methods;
+    }
+  }
 
   ClassDescriptor(Class cls, long classPtr)
   {
@@ -57,7 +88,7 @@ public class ClassDescriptor
 
   long getMethod(Method requestedMethod)
   {
-    for (int i = 0; i < methods.length; ++i)
+    for (int i = 0; i < methodCounter; ++i)
       if (this.methodIndex[i].equals(requestedMethod))
         return this.methods[i];
     return 0;
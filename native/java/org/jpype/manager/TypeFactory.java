@@ -165,7 +165,8 @@ public interface TypeFactory
    * @param context JPContext object
    * @param cls is the class that owns this dispatch.
    * @param name is the name of the dispatch.
-   * @param overloadList is the list of all methods constructed for this class.
+   * @param overloadList is the list of all methods constructed for this class,
+   * or null if the overloads will be assigned when first used.
    * @param modifiers contains if the method is (CTOR, STATIC),
    * @return the pointer to the JPMethodDispatch.
    */
@@ -176,6 +177,18 @@ public interface TypeFactory
           long[] overloadList,
           int modifiers);
 
+  /**
+   * Assign the overloads to a method dispatch which was defined without them.
+   *
+   * @param context JPContext object
+   * @param dispatch is the JPMethodDispatch to populate.
+   * @param overloadList is the list of JPMethod in order of precedence.
+   */
+  void assignOverloads(
+          long context,
+          long dispatch,
+          long[] overloadList);
+
 //</editor-fold>
 //<editor-fold desc="destroy" defaultstate="collapsed">
   /**
@@ -98,6 +98,12 @@ public class TypeFactoryNative implements TypeFactory
           long[] overloadList,
           int modifiers);
 
+  @Override
+  public native void assignOverloads(
+          long context,
+          long dispatch,
+          long[] overloadList);
+
   @Override
   public native void destroy(
           long context,
@@ -15,6 +15,7 @@
 **************************************************************************** */
 package org.jpype.manager;
 
+import java.io.File;
 import java.io.Serializable;
 import java.lang.annotation.Annotation;
 import java.lang.reflect.Array;
@@ -24,13 +25,13 @@ import java.lang.reflect.Field;
 import java.lang.reflect.Member;
 import java.lang.reflect.Method;
 import java.lang.reflect.Modifier;
-import java.lang.reflect.Proxy;
 import java.util.Arrays;
 import java.nio.Buffer;
 import java.util.HashMap;
 import java.util.Iterator;
 import java.util.LinkedList;
 import java.util.List;
+import java.util.Map;
 import java.util.TreeSet;
 import org.jpype.JPypeContext;
 import org.jpype.proxy.JPypeProxy;
@@ -49,6 +50,7 @@ public class TypeManager
   public TypeAudit audit = null;
   private ClassDescriptor java_lang_Object;
   public Class<? extends Annotation> functionalAnnotation = null;
+  public TypeSnapshot snapshot = null;
   // For reasons that are less than clear, this object cannot be created
   // during shutdown
   private Destroyer destroyer = new Destroyer();
@@ -82,6 +84,10 @@ public class TypeManager
         // It is okay if we don't find this
       }
 
+      String snapshotPath = System.getProperty("org.jpype.manager.snapshot");
+      if (snapshotPath != null)
+        this.snapshot = TypeSnapshot.open(new File(snapshotPath));
+
       // Create the required minimum classes
       this.java_lang_Object = createClass(Object.class, true);
 
@@ -136,31 +142,34 @@ public class TypeManager
     if (this.isShutdown)
       return 0;
 
-    long out;
+    // Anonymous and lambda classes are recorded under the wrapper they share
+    // so the lookup is only done once per class.
+    ClassDescriptor desc = this.classMap.get(cls);
+    if (desc != null)
+      return desc.classPtr;
+
     if (cls.isSynthetic() && cls.getSimpleName().contains("$Lambda$"))
     {
       // If is it lambda, we need a special wrapper
       // we don't want to create a class each time in that case.
       // Thus use the parent interface for this class
-      out = getClass(cls.getInterfaces()[0]).classPtr;
+      desc = getClass(cls.getInterfaces()[0]);
     } else if (cls.isAnonymousClass())
     {
       // This one is more of a burden.  It depends what whether is was
       // anonymous extends or implements.
       if (cls.getInterfaces().length == 1)
-        out = getClass(cls.getInterfaces()[0]).classPtr;
+        desc = getClass(cls.getInterfaces()[0]);
       else
-      {
-        ClassDescriptor parent = getClass(cls.getSuperclass());
-        out = createAnonymous(parent);
-      }
+        desc = createAnonymous(getClass(cls.getSuperclass()));
     } else
     {
       // Just a regular class
-      out = getClass(cls).classPtr;
+      return getClass(cls).classPtr;
     }
 
-    return out;
+    this.classMap.put(cls, desc);
+    return desc.classPtr;
   }
 
   /**
@@ -313,14 +322,12 @@ public class TypeManager
     if (object == null)
       return 0;
 
-    Class cls = object.getClass();
-    if (Proxy.isProxyClass(cls)
-            && (Proxy.getInvocationHandler(object) instanceof JPypeProxy))
+    if (JPypeProxy.isProxy(object))
     {
       return this.findClass(JPypeProxy.class);
     }
 
-    return this.findClass(cls);
+    return this.findClass(object.getClass());
   }
 
   /**
@@ -332,6 +339,9 @@ public class TypeManager
     // point forward.
     this.isShutdown = true;
 
+    if (this.snapshot != null)
+      this.snapshot.save();
+
     // Destroy all the resources held in C++
     for (ClassDescriptor entry : this.classMap.values())
     {
@@ -340,7 +350,6 @@ public class TypeManager
       destroyer.add(entry.methodDispatch);
       destroyer.add(entry.methods);
       destroyer.add(entry.fields);
-      destroyer.add(entry.anonymous);
       destroyer.add(entry.classPtr);
 
       // The same wrapper can appear more than once so blank as we go.
@@ -349,7 +358,7 @@ public class TypeManager
       entry.methodDispatch = null;
       entry.methods = null;
       entry.fields = null;
-      entry.anonymous = 0;
+      entry.anonymous = null;
       entry.classPtr = 0;
     }
     destroyer.flush();
@@ -460,16 +469,19 @@ public class TypeManager
     return out;
   }
 
-  private long createAnonymous(ClassDescriptor parent)
+  private ClassDescriptor createAnonymous(ClassDescriptor parent)
   {
-    if (parent.anonymous != 0)
+    if (parent.anonymous != null)
       return parent.anonymous;
 
-    parent.anonymous = typeFactory.defineObjectClass(context,
+    // The wrapper is destroyed through the entries of the anonymous classes
+    // which use it.
+    long classPtr = typeFactory.defineObjectClass(context,
             parent.cls, parent.cls.getCanonicalName() + "$Anonymous",
             parent.classPtr,
             null,
             ModifierCode.ANONYMOUS.value);
+    parent.anonymous = new ClassDescriptor(parent.cls, classPtr);
     return parent.anonymous;
   }
 
@@ -590,7 +602,8 @@ public class TypeManager
       return;
 
     // Sort them by precedence order
-    List<MethodResolution> overloads = MethodResolution.sortMethods(constructors);
+    List<MethodResolution> overloads = resolveOverloads(desc,
+            TypeSnapshot.CONSTRUCTOR, constructors);
 
     // Convert overload list to a list of overloads pointers
     desc.constructors = this.createConstructors(desc, overloads);
@@ -670,6 +683,7 @@ public class TypeManager
     desc.methods = new long[declaredMethods.size()];
     desc.methodIndex = new Method[declaredMethods.size()];
     desc.methodDispatch = new long[resolve.size()];
+    desc.pending = new HashMap<>();
 
     int i = 0;
     for (String name : resolve)
@@ -678,6 +692,16 @@ public class TypeManager
     }
   }
 
+  /**
+   * Create the dispatch for a method name.
+   * <p>
+   * The overloads are not resolved until the dispatch is first used.
+   *
+   * @param desc
+   * @param key is the name of the method.
+   * @param candidates is the list of methods still to be assigned.
+   * @return the pointer to the JPMethodDispatch.
+   */
   private long createMethodDispatch(
           ClassDescriptor desc,
           String key,
@@ -703,19 +727,126 @@ public class TypeManager
         modifiers |= ModifierCode.BEAN_MUTATOR.value;
     }
 
-    // Convert overload list to a list of overloads pointers
-    List<MethodResolution> overloads = MethodResolution.sortMethods(methods);
-    long[] overloadPtrs = this.createMethods(desc, overloads);
-
     long methodContainer = typeFactory.defineMethodDispatch(context,
             desc.classPtr,
             key,
-            overloadPtrs,
+            null,
             modifiers);
-
+    desc.pending.put(key, new ClassDescriptor.Pending(methodContainer, methods));
     return methodContainer;
   }
 
+  /**
+   * Resolve the overloads for a method dispatch.
+   * <p>
+   * This is called by JPype the first time a dispatch is used.
+   *
+   * @param cls is the class holding the dispatch.
+   * @param name is the name of the dispatch.
+   */
+  public synchronized void populateDispatch(Class cls, String name)
+  {
+    ClassDescriptor desc = this.classMap.get(cls);
+    if (desc == null)
+      throw new RuntimeException("Class not loaded");
+    populateDispatch(desc, name);
+  }
+
+  /**
+   * Create the wrapper for a class and resolve all of its members.
+   * <p>
+   * This is used to load classes ahead of use. The lock is released between
+   * each dispatch so that other threads are not held up for the whole class.
+   *
+   * @param cls is the class to load.
+   * @return true if the class was loaded.
+   */
+  public boolean populateAll(Class<?> cls)
+  {
+    if (findClass(cls) == 0)
+      return false;
+    String[] names;
+    synchronized (this)
+    {
+      ClassDescriptor desc = this.classMap.get(cls);
+      // The JVM may have been shutdown after the class was found.
+      if (desc == null)
+        return false;
+      populateMembers(cls);
+      if (desc.pending == null)
+        return true;
+      names = desc.pending.keySet().toArray(new String[desc.pending.size()]);
+    }
+    for (String name : names)
+    {
+      populateDispatch(cls, name);
+    }
+    return true;
+  }
+
+  private void populateDispatch(ClassDescriptor desc, String name)
+  {
+    if (desc.pending == null)
+      return;
+    ClassDescriptor.Pending pending = desc.pending.get(name);
+    if (pending == null)
+      return;
+
+    // The entry is kept until the overloads are assigned so that a failure
+    // is reported again on the next use rather than leaving the dispatch
+    // empty.
+    boolean retry = pending.attempted;
+    pending.attempted = true;
+
+    // Convert overload list to a list of overloads pointers
+    List<MethodResolution> overloads = resolveOverloads(desc, name, pending.methods);
+    long[] overloadPtrs = this.createMethods(desc, overloads, retry);
+    typeFactory.assignOverloads(context, pending.dispatch, overloadPtrs);
+    desc.pending.remove(name);
+  }
+
+  /**
+   * Sort a list of overloads by precedence.
+   * <p>
+   * If the snapshot has a valid record of the order, it is used rather than
+   * sorting again.
+   *
+   * @param desc is the class holding the overloads.
+   * @param name is the name of the dispatch.
+   * @param candidates is the list of overloads.
+   * @return the overloads ordered from most to least specific.
+   */
+  private <T extends Executable> List<MethodResolution> resolveOverloads(
+          ClassDescriptor desc, String name, List<T> candidates)
+  {
+    if (snapshot == null || !snapshot.covers(candidates))
+      return MethodResolution.sortMethods(candidates);
+
+    // The member counts identify the class in the snapshot and are only
+    // needed once for all of its dispatches.
+    Class<?> cls = desc.cls;
+    if (desc.methodCount < 0)
+    {
+      desc.methodCount = cls.getMethods().length;
+      desc.constructorCount = cls.getDeclaredConstructors().length;
+    }
+    int methodCount = desc.methodCount;
+    int constructorCount = desc.constructorCount;
+    TypeSnapshot.Entry entry = snapshot.get(cls, methodCount, constructorCount);
+    List<MethodResolution> overloads = null;
+    if (entry != null)
+      overloads = entry.restore(name, bySignature(candidates));
+    if (overloads != null && overloads.size() == candidates.size())
+    {
+      snapshot.restored++;
+      return overloads;
+    }
+
+    overloads = MethodResolution.sortMethods(candidates);
+    snapshot.create(cls, methodCount, constructorCount).add(name, overloads);
+    return overloads;
+  }
+
   /**
    * Convert a list of executable overload resolutions into a executable
    * overload list.
@@ -724,11 +855,14 @@ public class TypeManager
    *
    * @param desc
    * @param overloads
+   * @param retry is true if an earlier attempt may have defined some of the
+   * overloads.
    * @return a list of method overload wrappers.
    */
   private long[] createMethods(
           ClassDescriptor desc,
-          List<MethodResolution> overloads)
+          List<MethodResolution> overloads,
+          boolean retry)
   {
     int n = overloads.size();
     long[] overloadPtrs = new long[overloads.size()];
@@ -741,7 +875,9 @@ public class TypeManager
       if (method.getDeclaringClass() != desc.cls)
       {
         this.populateMembers(decl);
-        ov.ptr = this.classMap.get(decl).getMethod(method);
+        ClassDescriptor declDesc = this.classMap.get(decl);
+        this.populateDispatch(declDesc, method.getName());
+        ov.ptr = declDesc.getMethod(method);
         if (ov.ptr == 0)
         {
           if (audit != null)
@@ -752,6 +888,17 @@ public class TypeManager
         continue;
       }
 
+      // Reuse the overloads defined by an attempt which failed
+      if (retry)
+      {
+        ov.ptr = desc.getMethod(method);
+        if (ov.ptr != 0)
+        {
+          overloadPtrs[--n] = ov.ptr;
+          continue;
+        }
+      }
+
       // Determine what takes precedence
       int i = 0;
       long[] precedencePtrs = new long[ov.children.size()];
@@ -880,6 +1027,22 @@ public class TypeManager
     return out;
   }
 
+  /**
+   * Index a list of members by signature.
+   *
+   * @param members
+   * @return a map from the signature to the member.
+   */
+  public static <T extends Executable> Map<String, Executable> bySignature(List<T> members)
+  {
+    HashMap<String, Executable> out = new HashMap<>();
+    for (T member : members)
+    {
+      out.put(member.toString(), member);
+    }
+    return out;
+  }
+
 //</editor-fold>
 //<editor-fold desc="utilities" defaultstate="collapsed">
   /**
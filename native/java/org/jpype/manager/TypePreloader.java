@@ -0,0 +1,267 @@
+/* ****************************************************************************
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  See NOTICE file for details.
+**************************************************************************** */
+package org.jpype.manager;
+
+import java.lang.reflect.Modifier;
+import java.net.URI;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.Map;
+import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.ThreadFactory;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.atomic.AtomicInteger;
+import org.jpype.JPypeContext;
+import org.jpype.JPypeKeywords;
+import org.jpype.pkg.JPypePackageManager;
+
+/**
+ * Load classes on background threads before they are used.
+ * <p>
+ * Creating the wrapper for a class and resolving its members is the main
+ * cost of first use. Programs that know which packages they need can have
+ * this work done while Python is busy elsewhere. The packages are walked on
+ * one thread and the classes are then loaded by a pool of daemon threads.
+ * <p>
+ * The TypeManager is locked for each class and dispatch so the work is
+ * interleaved with any classes requested by Python in the meantime. The
+ * Python wrapper is created through the same path as a class requested by
+ * Python, which holds the GIL only while the wrapper is built.
+ */
+public class TypePreloader
+{
+
+  final JPypeContext context;
+  final TypeManager typeManager;
+  final ClassLoader classLoader;
+  final String[] patterns;
+  final ExecutorService executor;
+  final CountDownLatch done = new CountDownLatch(1);
+  final AtomicInteger loaded = new AtomicInteger();
+  final AtomicInteger failed = new AtomicInteger();
+  volatile int total = -1;
+  volatile long startTime;
+  volatile long endTime;
+
+  TypePreloader(JPypeContext context, String[] patterns, int threads)
+  {
+    this.context = context;
+    this.typeManager = context.getTypeManager();
+    this.classLoader = context.getClassLoader();
+    this.patterns = patterns;
+    this.executor = Executors.newFixedThreadPool(threads, new ThreadFactory()
+    {
+      final AtomicInteger count = new AtomicInteger();
+
+      @Override
+      public Thread newThread(Runnable r)
+      {
+        Thread thread = new Thread(r, "JPype-Preload-" + count.incrementAndGet());
+        thread.setDaemon(true);
+        return thread;
+      }
+    });
+  }
+
+  /**
+   * Start loading classes.
+   * <p>
+   * Patterns are either the name of a class or a package name followed by
+   * ".*" which loads every public class in the package and its subpackages.
+   *
+   * @param patterns is the list of classes and packages to load.
+   * @param threads is the number of threads to use or 0 for one per
+   * processor.
+   * @return a handle to monitor the progress.
+   */
+  public static TypePreloader start(String[] patterns, int threads)
+  {
+    if (threads <= 0)
+      threads = Runtime.getRuntime().availableProcessors();
+    final TypePreloader preloader = new TypePreloader(JPypeContext.getInstance(), patterns, threads);
+    preloader.startTime = System.nanoTime();
+    Thread thread = new Thread(new Runnable()
+    {
+      @Override
+      public void run()
+      {
+        preloader.run();
+      }
+    }, "JPype-Preload");
+    thread.setDaemon(true);
+    thread.start();
+    return preloader;
+  }
+
+  void run()
+  {
+    try
+    {
+      // The package walk is done on this thread and is serialized with
+      // Python imports by the package manager.
+      List<String> names = new ArrayList<>();
+      for (String pattern : patterns)
+      {
+        if (pattern.endsWith(".*"))
+          collect(pattern.substring(0, pattern.length() - 2), names);
+        else
+          names.add(pattern);
+      }
+      total = names.size();
+      for (final String name : names)
+      {
+        executor.execute(new Runnable()
+        {
+          @Override
+          public void run()
+          {
+            load(name);
+          }
+        });
+      }
+      executor.shutdown();
+      executor.awaitTermination(Long.MAX_VALUE, TimeUnit.NANOSECONDS);
+    } catch (InterruptedException ex)
+    {
+      executor.shutdownNow();
+    } finally
+    {
+      if (total < 0)
+        total = 0;
+      endTime = System.nanoTime();
+      done.countDown();
+    }
+  }
+
+  void collect(String packageName, List<String> out)
+  {
+    Map<String, URI> contents = JPypePackageManager.getContentMap(packageName);
+    for (Map.Entry<String, URI> entry : contents.entrySet())
+    {
+      String name = packageName + "." + JPypeKeywords.unwrap(entry.getKey());
+      if (entry.getValue().toString().endsWith(".class"))
+        out.add(name);
+      else
+        collect(name, out);
+    }
+  }
+
+  void load(String name)
+  {
+    if (typeManager.isShutdown)
+      return;
+    try
+    {
+      Class<?> cls = Class.forName(name, false, classLoader);
+      if (Modifier.isPublic(cls.getModifiers()) && typeManager.populateAll(cls))
+      {
+        long classPtr = typeManager.findClass(cls);
+        if (classPtr != 0 && !typeManager.isShutdown)
+        {
+          context.newWrapper(classPtr);
+          loaded.incrementAndGet();
+          return;
+        }
+      }
+    } catch (Throwable ex)
+    {
+      // Classes with missing dependencies are skipped.
+    }
+    failed.incrementAndGet();
+  }
+
+  /**
+   * Get the number of classes found.
+   *
+   * @return the number of classes to load or -1 if the packages are still
+   * being searched.
+   */
+  public int getTotal()
+  {
+    return total;
+  }
+
+  /**
+   * Get the number of classes loaded so far.
+   *
+   * @return the number of classes loaded.
+   */
+  public int getLoaded()
+  {
+    return loaded.get();
+  }
+
+  /**
+   * Get the number of classes that were skipped.
+   * <p>
+   * Classes which are not public or can't be loaded are skipped.
+   *
+   * @return the number of classes skipped.
+   */
+  public int getFailed()
+  {
+    return failed.get();
+  }
+
+  /**
+   * Check if the preload is complete.
+   *
+   * @return true if all classes have been processed.
+   */
+  public boolean isDone()
+  {
+    return done.getCount() == 0;
+  }
+
+  /**
+   * Wait for the preload to complete.
+   *
+   * @param millis is the longest time to wait or 0 to wait without limit.
+   * @return true if all classes have been processed.
+   * @throws InterruptedException if the wait was interrupted.
+   */
+  public boolean waitFor(long millis) throws InterruptedException
+  {
+    if (millis <= 0)
+    {
+      done.await();
+      return true;
+    }
+    return done.await(millis, TimeUnit.MILLISECONDS);
+  }
+
+  /**
+   * Get the time spent loading.
+   *
+   * @return the elapsed time in seconds.
+   */
+  public double getElapsed()
+  {
+    long end = isDone() ? endTime : System.nanoTime();
+    return (end - startTime) * 1e-9;
+  }
+
+  @Override
+  public String toString()
+  {
+    int n = total;
+    return String.format("Preloaded %d of %s classes (%d skipped) in %.3fs",
+            loaded.get(), n < 0 ? "?" : Integer.toString(n), failed.get(),
+            getElapsed());
+  }
+}
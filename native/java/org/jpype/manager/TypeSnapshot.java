@@ -0,0 +1,470 @@
+/* ****************************************************************************
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  See NOTICE file for details.
+**************************************************************************** */
+package org.jpype.manager;
+
+import java.io.BufferedInputStream;
+import java.io.BufferedOutputStream;
+import java.io.DataInputStream;
+import java.io.DataOutputStream;
+import java.io.File;
+import java.io.FileInputStream;
+import java.io.FileOutputStream;
+import java.io.IOException;
+import java.lang.reflect.Executable;
+import java.net.URISyntaxException;
+import java.security.CodeSource;
+import java.util.ArrayList;
+import java.util.HashMap;
+import java.util.HashSet;
+import java.util.IdentityHashMap;
+import java.util.LinkedHashMap;
+import java.util.List;
+import java.util.Map;
+import java.util.Set;
+
+/**
+ * On disk record of the resolved overloads for each class.
+ * <p>
+ * Ordering the overloads of a class requires comparing every overload with
+ * every other and filtering the overridden methods. The result depends only on
+ * the class, so it can be saved between runs. The snapshot is only used if
+ * the JVM version and the class path are unchanged. Each class is further
+ * checked against its current members before the record is used.
+ * <p>
+ * Only overloads whose classes and parameter types, along with all of their
+ * supertypes, come from the JDK or from jars on the class path are recorded.
+ * Directories and jars added later can change without changing the key.
+ * <p>
+ * The snapshot is enabled with the system property
+ * {@code org.jpype.manager.snapshot} which gives the file to use. It is
+ * written when the TypeManager is shutdown.
+ */
+public class TypeSnapshot
+{
+
+  static final int VERSION = 3;
+  static final String MAGIC = "JPypeTypeSnapshot";
+  static final String CONSTRUCTOR = "<init>";
+
+  final File file;
+  final String key;
+  // Jars which contribute to the key.
+  final HashSet<String> jars = new HashSet<>();
+  final HashMap<String, Entry> entries = new HashMap<>();
+  // Classes found to be covered by the key.
+  final IdentityHashMap<Class<?>, Boolean> covered = new IdentityHashMap<>();
+  boolean dirty = false;
+  int restored = 0;
+
+  /**
+   * Resolved overloads for one dispatch.
+   */
+  static class Overloads
+  {
+
+    String[] signatures;
+    int[][] children;
+  }
+
+  /**
+   * Resolved dispatches for one class.
+   */
+  static class Entry
+  {
+
+    int methodCount;
+    int constructorCount;
+    LinkedHashMap<String, Overloads> dispatches = new LinkedHashMap<>();
+
+    /**
+     * Record the order of a list of overloads.
+     *
+     * @param name is the name of the dispatch.
+     * @param overloads is the sorted list of overloads.
+     */
+    void add(String name, List<MethodResolution> overloads)
+    {
+      IdentityHashMap<MethodResolution, Integer> index = new IdentityHashMap<>();
+      Overloads ov = new Overloads();
+      int n = overloads.size();
+      ov.signatures = new String[n];
+      ov.children = new int[n][];
+      for (int i = 0; i < n; ++i)
+      {
+        MethodResolution mr = overloads.get(i);
+        index.put(mr, i);
+        ov.signatures[i] = mr.executable.toString();
+      }
+      for (int i = 0; i < n; ++i)
+      {
+        List<MethodResolution> children = overloads.get(i).children;
+        ov.children[i] = new int[children.size()];
+        for (int j = 0; j < children.size(); ++j)
+        {
+          ov.children[i][j] = index.get(children.get(j));
+        }
+      }
+      dispatches.put(name, ov);
+    }
+
+    /**
+     * Rebuild a list of overloads.
+     *
+     * @param name is the name of the dispatch.
+     * @param members is the current members of the class by signature.
+     * @return the sorted overloads or null if the class no longer matches.
+     */
+    List<MethodResolution> restore(String name, Map<String, Executable> members)
+    {
+      Overloads ov = dispatches.get(name);
+      if (ov == null)
+        return null;
+      ArrayList<MethodResolution> out = new ArrayList<>(ov.signatures.length);
+      for (String signature : ov.signatures)
+      {
+        Executable executable = members.get(signature);
+        if (executable == null)
+          return null;
+        out.add(new MethodResolution(executable));
+      }
+      for (int i = 0; i < ov.children.length; ++i)
+      {
+        for (int j : ov.children[i])
+        {
+          out.get(i).children.add(out.get(j));
+        }
+      }
+      return out;
+    }
+  }
+
+  TypeSnapshot(File file)
+  {
+    this.file = file;
+    this.key = fingerprint(jars);
+  }
+
+  /**
+   * Open a snapshot.
+   * <p>
+   * If the file is missing, unreadable or from a different environment an
+   * empty snapshot is returned which will replace it when saved.
+   *
+   * @param file is the file holding the snapshot.
+   * @return a new snapshot.
+   */
+  public static TypeSnapshot open(File file)
+  {
+    TypeSnapshot snapshot = new TypeSnapshot(file);
+    if (!file.exists())
+      return snapshot;
+    try (DataInputStream is = new DataInputStream(new BufferedInputStream(new FileInputStream(file))))
+    {
+      snapshot.read(is, file.length());
+    } catch (IOException | RuntimeException ex)
+    {
+      // A damaged snapshot is simply rebuilt.
+      snapshot.entries.clear();
+      snapshot.dirty = true;
+    }
+    return snapshot;
+  }
+
+  /**
+   * Check if the order of a list of overloads can be recorded.
+   *
+   * @param candidates is the list of overloads.
+   * @return true if every type which affects the order is covered by the key.
+   */
+  boolean covers(List<? extends Executable> candidates)
+  {
+    for (Executable executable : candidates)
+    {
+      if (!isCovered(executable.getDeclaringClass()))
+        return false;
+      for (Class<?> type : executable.getParameterTypes())
+      {
+        if (!isCovered(type))
+          return false;
+      }
+    }
+    return true;
+  }
+
+  /**
+   * Check if a class and its supertypes can't change without changing the
+   * key.
+   *
+   * @param cls is the class to check.
+   * @return true if the class is from the JDK or a jar on the class path.
+   */
+  boolean isCovered(Class<?> cls)
+  {
+    while (cls.isArray())
+    {
+      cls = cls.getComponentType();
+    }
+    if (cls.isPrimitive())
+      return true;
+    Boolean result = covered.get(cls);
+    if (result != null)
+      return result;
+    boolean out = isSourceCovered(cls);
+    if (out && cls.getSuperclass() != null)
+      out = isCovered(cls.getSuperclass());
+    for (Class<?> intf : cls.getInterfaces())
+    {
+      if (!out)
+        break;
+      out = isCovered(intf);
+    }
+    covered.put(cls, out);
+    return out;
+  }
+
+  private boolean isSourceCovered(Class<?> cls)
+  {
+    ClassLoader cl = cls.getClassLoader();
+    // Classes from the JDK are covered by the version.
+    if (cl == null || cl == ClassLoader.getSystemClassLoader().getParent())
+      return true;
+    try
+    {
+      CodeSource source = cls.getProtectionDomain().getCodeSource();
+      if (source == null || source.getLocation() == null
+              || !"file".equals(source.getLocation().getProtocol()))
+        return false;
+      File f = new File(source.getLocation().toURI());
+      return jars.contains(f.getAbsolutePath());
+    } catch (URISyntaxException | RuntimeException ex)
+    {
+      return false;
+    }
+  }
+
+  /**
+   * Get the record for a class.
+   *
+   * @param cls is the class to look up.
+   * @param methods is the current public methods of the class.
+   * @param constructors is the current declared constructors of the class.
+   * @return the record or null if there is none for this class.
+   */
+  Entry get(Class<?> cls, int methods, int constructors)
+  {
+    Entry entry = entries.get(cls.getName());
+    if (entry == null || entry.methodCount != methods
+            || entry.constructorCount != constructors)
+      return null;
+    return entry;
+  }
+
+  /**
+   * Start a new record for a class.
+   *
+   * @param cls is the class being resolved.
+   * @param methods is the current public methods of the class.
+   * @param constructors is the current declared constructors of the class.
+   * @return a new empty record.
+   */
+  Entry create(Class<?> cls, int methods, int constructors)
+  {
+    Entry entry = entries.get(cls.getName());
+    if (entry == null || entry.methodCount != methods
+            || entry.constructorCount != constructors)
+    {
+      entry = new Entry();
+      entry.methodCount = methods;
+      entry.constructorCount = constructors;
+      entries.put(cls.getName(), entry);
+    }
+    dirty = true;
+    return entry;
+  }
+
+  /**
+   * Write the snapshot if it has changed.
+   */
+  public void save()
+  {
+    if (!dirty)
+      return;
+    File tmp = new File(file.getPath() + ".tmp");
+    try
+    {
+      try (DataOutputStream os = new DataOutputStream(new BufferedOutputStream(new FileOutputStream(tmp))))
+      {
+        write(os);
+      }
+      if (!tmp.renameTo(file))
+      {
+        file.delete();
+        tmp.renameTo(file);
+      }
+      dirty = false;
+    } catch (IOException ex)
+    {
+      // The snapshot is only an optimization so failure to write it is
+      // not an error.
+      tmp.delete();
+    }
+  }
+
+  /**
+   * Compute the key for the current environment.
+   * <p>
+   * Every entry on the class path contributes its name, size and
+   * modification time so that a changed jar invalidates the snapshot.
+   *
+   * @param jars is filled with the jars which are part of the key.
+   * @return a key for the environment.
+   */
+  static String fingerprint(Set<String> jars)
+  {
+    StringBuilder sb = new StringBuilder();
+    sb.append(System.getProperty("java.vm.name")).append(';');
+    sb.append(System.getProperty("java.vm.version")).append(';');
+    sb.append(System.getProperty("java.version"));
+    String path = System.getProperty("java.class.path", "");
+    for (String element : path.split(File.pathSeparator))
+    {
+      if (element.isEmpty())
+        continue;
+      File f = new File(element);
+      if (f.isFile())
+        jars.add(f.getAbsolutePath());
+      sb.append(';').append(f.getAbsolutePath())
+              .append(':').append(f.length())
+              .append(':').append(f.lastModified());
+    }
+    return sb.toString();
+  }
+
+  /**
+   * Get the number of dispatches restored from the snapshot.
+   *
+   * @return the number of dispatches which did not need to be sorted.
+   */
+  public int getRestored()
+  {
+    return restored;
+  }
+
+  /**
+   * Read a count from the snapshot.
+   * <p>
+   * Counts are checked against the size of the file so that a damaged file
+   * can't request an enormous allocation.
+   *
+   * @param is is the stream to read.
+   * @param size is the least number of bytes used by each item.
+   * @param limit is the size of the file.
+   * @return the count.
+   * @throws IOException if the count can't be valid.
+   */
+  static int readCount(DataInputStream is, int size, long limit) throws IOException
+  {
+    int n = is.readInt();
+    if (n < 0 || (long) n * size > limit)
+      throw new IOException("Snapshot is damaged");
+    return n;
+  }
+
+  void read(DataInputStream is, long limit) throws IOException
+  {
+    if (!MAGIC.equals(is.readUTF()) || is.readInt() != VERSION)
+    {
+      dirty = true;
+      return;
+    }
+    int n = readCount(is, 2, limit);
+    char[] buffer = new char[n];
+    for (int i = 0; i < n; ++i)
+    {
+      buffer[i] = is.readChar();
+    }
+    if (!key.equals(new String(buffer)))
+    {
+      dirty = true;
+      return;
+    }
+    int classes = readCount(is, 14, limit);
+    for (int i = 0; i < classes; ++i)
+    {
+      String name = is.readUTF();
+      Entry entry = new Entry();
+      entry.methodCount = is.readInt();
+      entry.constructorCount = is.readInt();
+      int dispatches = readCount(is, 6, limit);
+      for (int j = 0; j < dispatches; ++j)
+      {
+        String dispatch = is.readUTF();
+        Overloads ov = new Overloads();
+        int overloads = readCount(is, 6, limit);
+        ov.signatures = new String[overloads];
+        ov.children = new int[overloads][];
+        for (int k = 0; k < overloads; ++k)
+        {
+          ov.signatures[k] = is.readUTF();
+          int children = readCount(is, 4, limit);
+          ov.children[k] = new int[children];
+          for (int l = 0; l < children; ++l)
+          {
+            int child = is.readInt();
+            if (child < 0 || child >= overloads)
+              throw new IOException("Snapshot is damaged");
+            ov.children[k][l] = child;
+          }
+        }
+        entry.dispatches.put(dispatch, ov);
+      }
+      entries.put(name, entry);
+    }
+  }
+
+  void write(DataOutputStream os) throws IOException
+  {
+    os.writeUTF(MAGIC);
+    os.writeInt(VERSION);
+    // The key can be longer than writeUTF allows.
+    os.writeInt(key.length());
+    os.writeChars(key);
+    os.writeInt(entries.size());
+    for (Map.Entry<String, Entry> item : entries.entrySet())
+    {
+      Entry entry = item.getValue();
+      os.writeUTF(item.getKey());
+      os.writeInt(entry.methodCount);
+      os.writeInt(entry.constructorCount);
+      os.writeInt(entry.dispatches.size());
+      for (Map.Entry<String, Overloads> dispatch : entry.dispatches.entrySet())
+      {
+        Overloads ov = dispatch.getValue();
+        os.writeUTF(dispatch.getKey());
+        os.writeInt(ov.signatures.length);
+        for (int k = 0; k < ov.signatures.length; ++k)
+        {
+          os.writeUTF(ov.signatures[k]);
+          os.writeInt(ov.children[k].length);
+          for (int child : ov.children[k])
+          {
+            os.writeInt(child);
+          }
+        }
+      }
+    }
+  }
+}
@@ -45,6 +45,9 @@ public class JPypePackage
   // A mapping from Python names into Paths into the module/jar file system.
   Map<String, URI> contents;
   int code;
+  // Read by JPype to decide if names not found may be cached.
+  boolean directory;
+  int directoryGeneration;
   private final DynamicClassLoader classLoader;
 
   public JPypePackage(String pkg)
@@ -53,6 +56,8 @@ public class JPypePackage
     this.contents = JPypePackageManager.getContentMap(pkg);
     this.classLoader = ((DynamicClassLoader)(JPypeContext.getInstance().getClassLoader()));
     this.code = classLoader.getCode();
+    this.directoryGeneration = classLoader.getGeneration();
+    this.directory = isDirectory(pkg);
   }
 
   /**
@@ -96,9 +101,35 @@ public class JPypePackage
     {
       // Continue
     }
+    int generation = classLoader.getGeneration();
+    if (directoryGeneration != generation)
+    {
+      directoryGeneration = generation;
+      directory = isDirectory(pkg);
+    }
     return null;
   }
 
+  /**
+   * Determine if a package is found in a directory on the class path.
+   *
+   * Classes can be added to a directory at any time, so names that are not
+   * found in such a package must be probed again.
+   *
+   * @param pkg is the name of the package.
+   * @return true if any part of the package is in a directory.
+   */
+  static boolean isDirectory(String pkg)
+  {
+    String path = pkg.replace('.', '/');
+    for (Path directory : JPypePackageManager.getDirectories())
+    {
+      if (Files.isDirectory(directory.resolve(path)))
+        return true;
+    }
+    return false;
+  }
+
   /**
    * Get a list of contents from a Java package.
    *
@@ -110,24 +141,28 @@ public class JPypePackage
   {
     checkCache();
     ArrayList<String> out = new ArrayList<>();
-    for (String key : contents.keySet())
+    // The paths are only valid while the package manager is locked.
+    synchronized (JPypePackageManager.class)
     {
-      URI uri = contents.get(key);
-      // If there is anything null, then skip it.
-      if (uri == null)
-        continue;
-      Path p = JPypePackageManager.getPath(uri);
-
-      // package are acceptable
-      if (Files.isDirectory(p))
-        out.add(key);
-
-      // classes must be public
-      else if (uri.toString().endsWith(".class"))
+      for (String key : contents.keySet())
       {
-        // Make sure it is public
-        if (isPublic(p))
+        URI uri = contents.get(key);
+        // If there is anything null, then skip it.
+        if (uri == null)
+          continue;
+        Path p = JPypePackageManager.getPath(uri);
+
+        // package are acceptable
+        if (Files.isDirectory(p))
           out.add(key);
+
+        // classes must be public
+        else if (uri.toString().endsWith(".class"))
+        {
+          // Make sure it is public
+          if (isPublic(p))
+            out.add(key);
+        }
       }
     }
     return out.toArray(new String[out.size()]);
@@ -0,0 +1,450 @@
+/* ****************************************************************************
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  See NOTICE file for details.
+**************************************************************************** */
+package org.jpype.pkg;
+
+import java.io.BufferedInputStream;
+import java.io.BufferedOutputStream;
+import java.io.DataInputStream;
+import java.io.DataOutputStream;
+import java.io.File;
+import java.io.FileInputStream;
+import java.io.FileOutputStream;
+import java.io.IOException;
+import java.net.URI;
+import java.net.URISyntaxException;
+import java.net.URL;
+import java.net.URLClassLoader;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.nio.file.Paths;
+import java.util.ArrayList;
+import java.util.Enumeration;
+import java.util.HashMap;
+import java.util.HashSet;
+import java.util.LinkedHashMap;
+import java.util.List;
+import java.util.Map;
+import java.util.jar.Attributes;
+import java.util.jar.JarEntry;
+import java.util.jar.JarFile;
+import java.util.jar.Manifest;
+import org.jpype.JPypeContext;
+import org.jpype.JPypeKeywords;
+import org.jpype.classloader.DynamicClassLoader;
+
+/**
+ * Index of the packages and classes held in the jars on the class path.
+ * <p>
+ * Probing the class loader for a package requires every jar to be searched
+ * and the matching jars to be opened as file systems. With many jars each
+ * import repeats this work. The index reads the directory of each jar once
+ * and then answers package queries from memory. Directories on the class path
+ * are still searched directly as their contents may change.
+ * <p>
+ * Jars added to the DynamicClassLoader are indexed when they are first
+ * needed. If the system property {@code org.jpype.pkg.index} is set, the
+ * listing of each jar is saved to that file and reused by later runs so long
+ * as the size and modification time of the jar are unchanged.
+ * <p>
+ * The index is not used if there is a module path as its contents are not
+ * visible here.
+ */
+public class JPypePackageIndex
+{
+
+  static final int VERSION = 1;
+  static final String MAGIC = "JPypePackageIndex";
+  static final String VERSIONS = "META-INF/versions/";
+  private static JPypePackageIndex INSTANCE;
+  private static boolean disabled = false;
+
+  final File file;
+  final DynamicClassLoader classLoader;
+  int code;
+  // Listings by jar including those loaded from the file but not used.
+  final LinkedHashMap<String, Jar> jars = new LinkedHashMap<>();
+  final HashSet<String> indexed = new HashSet<>();
+  final List<Path> directories = new ArrayList<>();
+  // Contents of each package by path.
+  final HashMap<String, Map<String, URI>> packages = new HashMap<>();
+  boolean dirty = false;
+
+  /**
+   * Listing of a jar.
+   */
+  static class Jar
+  {
+
+    String path;
+    long length;
+    long modified;
+    String[] entries;
+    String[] classPath;
+  }
+
+  JPypePackageIndex(File file, DynamicClassLoader classLoader)
+  {
+    this.file = file;
+    this.classLoader = classLoader;
+    this.code = classLoader.getCode();
+  }
+
+  /**
+   * Get the index for the current class path.
+   *
+   * @return the index or null if it can't be used.
+   */
+  public static synchronized JPypePackageIndex getInstance()
+  {
+    if (INSTANCE != null || disabled)
+    {
+      if (INSTANCE != null)
+        INSTANCE.update();
+      return INSTANCE;
+    }
+    ClassLoader cl = JPypeContext.getInstance().getClassLoader();
+    if (!(cl instanceof DynamicClassLoader) || System.getProperty("jdk.module.path") != null)
+    {
+      disabled = true;
+      return null;
+    }
+    String path = System.getProperty("org.jpype.pkg.index");
+    JPypePackageIndex index = new JPypePackageIndex(path == null ? null : new File(path),
+            (DynamicClassLoader) cl);
+    index.load();
+    index.build();
+    index.save();
+    INSTANCE = index;
+    return index;
+  }
+
+  /**
+   * Check if a path is a package.
+   *
+   * @param name is the package with / as the separator.
+   * @return true if the package is found in a jar or class path directory.
+   */
+  public synchronized boolean isPackage(String name)
+  {
+    if (packages.containsKey(name))
+      return true;
+    for (Path directory : directories)
+    {
+      if (Files.isDirectory(directory.resolve(name)))
+        return true;
+    }
+    return false;
+  }
+
+  /**
+   * Get the contents of a package.
+   *
+   * @param out is the map to store the result in.
+   * @param name is the package with / as the separator.
+   */
+  public synchronized void getContents(Map<String, URI> out, String name)
+  {
+    Map<String, URI> contents = packages.get(name);
+    if (contents != null)
+      out.putAll(contents);
+    for (Path directory : directories)
+    {
+      Path path = directory.resolve(name);
+      if (Files.isDirectory(path))
+        JPypePackageManager.collectContents(out, path);
+    }
+  }
+
+//<editor-fold desc="build" defaultstate="collapsed">
+  /**
+   * Index any jars added since the last use.
+   */
+  synchronized void update()
+  {
+    int current = classLoader.getCode();
+    if (this.code == current)
+      return;
+    this.code = current;
+    build();
+    save();
+  }
+
+  private void build()
+  {
+    for (String element : System.getProperty("java.class.path", "").split(File.pathSeparator))
+    {
+      if (!element.isEmpty())
+        add(Paths.get(element).toAbsolutePath());
+    }
+    ClassLoader parent = classLoader.getParent();
+    if (parent instanceof URLClassLoader)
+      addLoader((URLClassLoader) parent);
+    for (URLClassLoader loader : classLoader.getLoaders())
+    {
+      addLoader(loader);
+    }
+  }
+
+  private void addLoader(URLClassLoader loader)
+  {
+    for (URL url : loader.getURLs())
+    {
+      try
+      {
+        add(Paths.get(url.toURI()).toAbsolutePath());
+      } catch (URISyntaxException | IllegalArgumentException ex)
+      {
+        // Only local files can be indexed.
+      }
+    }
+  }
+
+  private void add(Path path)
+  {
+    String name = path.toString();
+    if (!indexed.add(name))
+      return;
+    if (Files.isDirectory(path))
+    {
+      directories.add(path);
+      return;
+    }
+    if (!Files.exists(path))
+      return;
+    Jar jar = list(path);
+    if (jar == null)
+      return;
+    URI base = path.toUri();
+    for (String entry : jar.entries)
+    {
+      // Entries in the overlays of a multi-release jar belong to the
+      // same packages as the base entries.
+      String name = entry;
+      if (name.startsWith(VERSIONS))
+      {
+        int i = name.indexOf('/', VERSIONS.length());
+        if (i == -1 || i + 1 == name.length())
+          continue;
+        name = name.substring(i + 1);
+      }
+      addEntry(base, name, entry);
+    }
+  }
+
+  /**
+   * Get the listing for a jar.
+   * <p>
+   * The saved listing is used if the jar is unchanged. Jars named in the
+   * manifest class path are added as well.
+   */
+  private Jar list(Path path)
+  {
+    File f = path.toFile();
+    Jar jar = jars.get(f.getPath());
+    if (jar == null || jar.length != f.length() || jar.modified != f.lastModified())
+    {
+      jar = read(f);
+      if (jar == null)
+        return null;
+      jars.put(jar.path, jar);
+      dirty = true;
+    }
+    for (String element : jar.classPath)
+    {
+      try
+      {
+        add(path.resolveSibling(element).normalize());
+      } catch (RuntimeException ex)
+      {
+        // Bad entries are ignored as by the class loader.
+      }
+    }
+    return jar;
+  }
+
+  private static Jar read(File f)
+  {
+    try (JarFile jf = new JarFile(f))
+    {
+      Jar jar = new Jar();
+      jar.path = f.getPath();
+      jar.length = f.length();
+      jar.modified = f.lastModified();
+      ArrayList<String> entries = new ArrayList<>();
+      Enumeration<JarEntry> e = jf.entries();
+      while (e.hasMoreElements())
+      {
+        String entry = e.nextElement().getName();
+        // Skip over META-INF and inner classes
+        if (entry.startsWith("META-INF/") && !entry.startsWith(VERSIONS))
+          continue;
+        if (entry.endsWith(".class") && entry.contains("$"))
+          continue;
+        if (entry.endsWith(".class") || entry.endsWith("/"))
+          entries.add(entry);
+      }
+      jar.entries = entries.toArray(new String[entries.size()]);
+      jar.classPath = new String[0];
+      Manifest manifest = jf.getManifest();
+      if (manifest != null)
+      {
+        String classPath = manifest.getMainAttributes().getValue(Attributes.Name.CLASS_PATH);
+        if (classPath != null && !classPath.trim().isEmpty())
+          jar.classPath = classPath.trim().split("\\s+");
+      }
+      return jar;
+    } catch (IOException ex)
+    {
+      // Anything goes wrong skip it
+      return null;
+    }
+  }
+
+  private void addEntry(URI base, String entry, String raw)
+  {
+    boolean isDirectory = entry.endsWith("/");
+    if (isDirectory)
+      entry = entry.substring(0, entry.length() - 1);
+    int i = entry.lastIndexOf('/');
+    if (i == -1 && !isDirectory)
+      return;
+    String parent = i == -1 ? "" : entry.substring(0, i);
+    String name = entry.substring(i + 1);
+    if (isDirectory)
+    {
+      if (!packages.containsKey(entry))
+        packages.put(entry, new HashMap<String, URI>());
+      name = JPypeKeywords.wrap(name);
+    } else
+    {
+      name = JPypeKeywords.wrap(name.substring(0, name.length() - 6));
+    }
+    if (parent.isEmpty())
+      return;
+
+    // Jars are not required to have entries for directories.
+    Map<String, URI> contents = packages.get(parent);
+    if (contents == null)
+    {
+      String rawParent = raw.substring(0, raw.lastIndexOf('/', raw.length() - 2) + 1);
+      addEntry(base, parent + "/", rawParent);
+      contents = packages.get(parent);
+    }
+    if (!contents.containsKey(name))
+      contents.put(name, toURI(base, raw));
+  }
+
+  private static URI toURI(URI base, String entry)
+  {
+    try
+    {
+      String path = new URI(null, null, "/" + entry, null).getRawPath();
+      return new URI("jar:" + base.toString() + "!" + path);
+    } catch (URISyntaxException ex)
+    {
+      // This should never happen
+      throw new RuntimeException(ex);
+    }
+  }
+//</editor-fold>
+//<editor-fold desc="file" defaultstate="collapsed">
+
+  private void load()
+  {
+    if (file == null || !file.exists())
+      return;
+    try (DataInputStream is = new DataInputStream(new BufferedInputStream(new FileInputStream(file))))
+    {
+      if (!MAGIC.equals(is.readUTF()) || is.readInt() != VERSION)
+        return;
+      int n = is.readInt();
+      for (int i = 0; i < n; ++i)
+      {
+        Jar jar = new Jar();
+        jar.path = is.readUTF();
+        jar.length = is.readLong();
+        jar.modified = is.readLong();
+        jar.entries = new String[is.readInt()];
+        for (int j = 0; j < jar.entries.length; ++j)
+        {
+          jar.entries[j] = is.readUTF();
+        }
+        jar.classPath = new String[is.readInt()];
+        for (int j = 0; j < jar.classPath.length; ++j)
+        {
+          jar.classPath[j] = is.readUTF();
+        }
+        jars.put(jar.path, jar);
+      }
+    } catch (IOException | RuntimeException ex)
+    {
+      // A damaged index is simply rebuilt.
+      jars.clear();
+      dirty = true;
+    }
+  }
+
+  private void save()
+  {
+    if (file == null || !dirty)
+      return;
+    File tmp = new File(file.getPath() + ".tmp");
+    try
+    {
+      try (DataOutputStream os = new DataOutputStream(new BufferedOutputStream(new FileOutputStream(tmp))))
+      {
+        os.writeUTF(MAGIC);
+        os.writeInt(VERSION);
+        // Jars which are no longer used are dropped.
+        ArrayList<Jar> used = new ArrayList<>();
+        for (Jar jar : jars.values())
+        {
+          if (indexed.contains(jar.path))
+            used.add(jar);
+        }
+        os.writeInt(used.size());
+        for (Jar jar : used)
+        {
+          os.writeUTF(jar.path);
+          os.writeLong(jar.length);
+          os.writeLong(jar.modified);
+          os.writeInt(jar.entries.length);
+          for (String entry : jar.entries)
+          {
+            os.writeUTF(entry);
+          }
+          os.writeInt(jar.classPath.length);
+          for (String element : jar.classPath)
+          {
+            os.writeUTF(element);
+          }
+        }
+      }
+      if (!tmp.renameTo(file))
+      {
+        file.delete();
+        tmp.renameTo(file);
+      }
+      dirty = false;
+    } catch (IOException ex)
+    {
+      // The index is only an optimization so failure to write it is
+      // not an error.
+      tmp.delete();
+    }
+  }
+//</editor-fold>
+}
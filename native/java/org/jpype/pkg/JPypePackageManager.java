@@ -15,10 +15,12 @@
 **************************************************************************** */
 package org.jpype.pkg;
 
+import java.io.File;
 import java.io.IOException;
 import java.net.URI;
 import java.net.URISyntaxException;
 import java.net.URL;
+import java.net.URLClassLoader;
 import java.nio.file.FileSystem;
 import java.nio.file.FileSystemNotFoundException;
 import java.nio.file.FileSystems;
@@ -36,6 +38,7 @@ import java.util.List;
 import java.util.Map;
 import org.jpype.JPypeContext;
 import org.jpype.JPypeKeywords;
+import org.jpype.classloader.DynamicClassLoader;
 
 /**
  * Manager for the contents of a package.
@@ -48,6 +51,11 @@ import org.jpype.JPypeKeywords;
  * a package in general nor to retrieve the package contents, but this appears
  * to be largely incorrect as the jar and jrt file system provide all the
  * required methods.
+ * <p>
+ * Packages may be searched by the preloader while Python imports, so the
+ * methods which walk the file systems are synchronized on this class. Paths
+ * returned by getPath are only valid while that lock is held as the jar file
+ * systems are closed as others are opened.
  *
  */
 public class JPypePackageManager
@@ -66,7 +74,7 @@ public class JPypePackageManager
    * @return true if this is a Java package either in a jar, module, or in the
    * boot path.
    */
-  public static boolean isPackage(String name)
+  public static synchronized boolean isPackage(String name)
   {
     if (name.indexOf('.') != -1)
       name = name.replace(".", "/");
@@ -81,7 +89,7 @@ public class JPypePackageManager
    * @param packageName
    * @return the list of all resources found.
    */
-  public static Map<String, URI> getContentMap(String packageName)
+  public static synchronized Map<String, URI> getContentMap(String packageName)
   {
     Map<String, URI> out = new HashMap<>();
     packageName = packageName.replace(".", "/");
@@ -100,7 +108,7 @@ public class JPypePackageManager
    * @param uri is the location of the resource.
    * @return the path to the uri resource.
    */
-  static Path getPath(URI uri)
+  static synchronized Path getPath(URI uri)
   {
     try
     {
@@ -350,6 +358,9 @@ public class JPypePackageManager
    */
   private static boolean isJarPackage(String name)
   {
+    JPypePackageIndex index = JPypePackageIndex.getInstance();
+    if (index != null)
+      return index.isPackage(name);
     ClassLoader cl = JPypeContext.getInstance().getClassLoader();
     try
     {
@@ -366,6 +377,68 @@ public class JPypePackageManager
     return false;
   }
 
+  // Directories on the class path and the loader code they were found for.
+  private static List<Path> directories;
+  private static int directoriesCode;
+
+  /**
+   * Get the directories on the class path.
+   * <p>
+   * These are found from the class path and the URLs of the class loaders
+   * so that no resource search is required. The list is rebuilt when jars
+   * are added.
+   *
+   * @return the directories in the order they are searched.
+   */
+  static synchronized List<Path> getDirectories()
+  {
+    ClassLoader cl = JPypeContext.getInstance().getClassLoader();
+    int code = (cl instanceof DynamicClassLoader) ? ((DynamicClassLoader) cl).getCode() : 0;
+    if (directories != null && directoriesCode == code)
+      return directories;
+    List<Path> out = new ArrayList<>();
+    for (String element : System.getProperty("java.class.path", "").split(File.pathSeparator))
+    {
+      if (!element.isEmpty())
+        addDirectory(out, Paths.get(element).toAbsolutePath());
+    }
+    if (cl instanceof DynamicClassLoader)
+    {
+      ClassLoader parent = cl.getParent();
+      if (parent instanceof URLClassLoader)
+        addDirectories(out, (URLClassLoader) parent);
+      for (URLClassLoader loader : ((DynamicClassLoader) cl).getLoaders())
+      {
+        addDirectories(out, loader);
+      }
+    }
+    directories = out;
+    directoriesCode = code;
+    return out;
+  }
+
+  private static void addDirectories(List<Path> out, URLClassLoader loader)
+  {
+    for (URL url : loader.getURLs())
+    {
+      if (!"file".equals(url.getProtocol()))
+        continue;
+      try
+      {
+        addDirectory(out, Paths.get(url.toURI()).toAbsolutePath());
+      } catch (URISyntaxException | IllegalArgumentException ex)
+      {
+        // Only local directories can change.
+      }
+    }
+  }
+
+  private static void addDirectory(List<Path> out, Path path)
+  {
+    if (Files.isDirectory(path) && !out.contains(path))
+      out.add(path);
+  }
+
   /**
    * Retrieve a list of packages and classes stored on a file system or in a
    * jar.
@@ -375,10 +448,16 @@ public class JPypePackageManager
    */
   private static void getJarContents(Map<String, URI> out, String packageName)
   {
+    String path = packageName.replace('.', '/');
+    JPypePackageIndex index = JPypePackageIndex.getInstance();
+    if (index != null)
+    {
+      index.getContents(out, path);
+      return;
+    }
     ClassLoader cl = JPypeContext.getInstance().getClassLoader();
     try
     {
-      String path = packageName.replace('.', '/');
       Enumeration<URL> resources = cl.getResources(path);
       while (resources.hasMoreElements())
       {
@@ -424,7 +503,7 @@ public class JPypePackageManager
    * @param out is the map to store the result in.
    * @param path2 is a path holding a directory to probe.
    */
-  private static void collectContents(Map<String, URI> out, Path path2)
+  static void collectContents(Map<String, URI> out, Path path2)
   {
     try
     {
@@ -0,0 +1,54 @@
+/* ****************************************************************************
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  See NOTICE file for details.
+**************************************************************************** */
+package org.jpype.proxy;
+
+import java.lang.reflect.Method;
+
+/**
+ * (internal) Base class for proxy classes generated by JPypeProxyGenerator.
+ * <p>
+ * Each generated method packs its arguments and calls invokeHost with the
+ * position of the method in the generated class. This skips the
+ * InvocationHandler and the reflective Method lookup of a
+ * java.lang.reflect.Proxy.
+ */
+public abstract class JPypeGeneratedProxy
+{
+
+  final JPypeProxy handler;
+  final Method[] methods;
+  final JPypeProxy.MethodInfo[] infos;
+
+  protected JPypeGeneratedProxy(JPypeProxy handler, Method[] methods)
+  {
+    this.handler = handler;
+    this.methods = methods;
+    this.infos = new JPypeProxy.MethodInfo[methods.length];
+  }
+
+  protected final Object invokeHost(int id, Object[] args)
+  {
+    if (handler.context.isShutdown())
+      throw new RuntimeException("Proxy called during shutdown");
+    JPypeProxy.MethodInfo info = infos[id];
+    if (info == null)
+    {
+      info = handler.resolve(methods[id]);
+      infos[id] = info;
+    }
+    return handler.dispatch(methods[id].getName(), info, args);
+  }
+}
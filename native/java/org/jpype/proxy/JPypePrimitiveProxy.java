@@ -0,0 +1,686 @@
+/* ****************************************************************************
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  See NOTICE file for details.
+**************************************************************************** */
+package org.jpype.proxy;
+
+import java.lang.reflect.Method;
+import java.lang.reflect.Modifier;
+import java.util.function.*;
+
+/**
+ * (internal) Proxy for the primitive functional interfaces.
+ * <p>
+ * A java.lang.reflect.Proxy boxes every primitive argument and return value.
+ * The primitive specializations in java.util.function are often called in
+ * tight loops, so for those we use a concrete class which passes the
+ * primitives to Python without boxing.
+ * <p>
+ * Arguments are passed to native in slots by kind. Integral arguments use the
+ * long slots, floating point arguments use the double slots, and objects use
+ * the object slot.
+ *
+ * @author nelson85
+ */
+public abstract class JPypePrimitiveProxy
+{
+
+  final JPypeProxy handler;
+  final String name;
+  final int index;
+  final long returnType;
+  final long[] parameterTypes;
+
+  JPypePrimitiveProxy(JPypeProxy handler, Method method)
+  {
+    JPypeProxy.MethodInfo info = handler.resolve(method);
+    this.handler = handler;
+    this.name = method.getName();
+    this.index = info.index;
+    this.returnType = info.returnType;
+    this.parameterTypes = info.parameterTypes;
+  }
+
+  /**
+   * Create a primitive proxy if one is available.
+   *
+   * @param handler is the handler for the proxy.
+   * @return the proxy instance or null if the interfaces are not supported.
+   */
+  static Object create(JPypeProxy handler)
+  {
+    if (handler.interfaces.length != 1)
+      return null;
+    Class<?> intf = handler.interfaces[0];
+    if (intf.getClassLoader() != null
+            || !intf.getName().startsWith("java.util.function."))
+      return null;
+    Method method = null;
+    for (Method m : intf.getMethods())
+    {
+      if (Modifier.isAbstract(m.getModifiers()))
+        method = m;
+    }
+    if (method == null)
+      return null;
+    if (intf == IntUnaryOperator.class)
+      return new IntUnary(handler, method);
+    if (intf == IntBinaryOperator.class)
+      return new IntBinary(handler, method);
+    if (intf == LongUnaryOperator.class)
+      return new LongUnary(handler, method);
+    if (intf == LongBinaryOperator.class)
+      return new LongBinary(handler, method);
+    if (intf == DoubleUnaryOperator.class)
+      return new DoubleUnary(handler, method);
+    if (intf == DoubleBinaryOperator.class)
+      return new DoubleBinary(handler, method);
+    if (intf == IntPredicate.class)
+      return new IntTest(handler, method);
+    if (intf == LongPredicate.class)
+      return new LongTest(handler, method);
+    if (intf == DoublePredicate.class)
+      return new DoubleTest(handler, method);
+    if (intf == IntConsumer.class)
+      return new IntAccept(handler, method);
+    if (intf == LongConsumer.class)
+      return new LongAccept(handler, method);
+    if (intf == DoubleConsumer.class)
+      return new DoubleAccept(handler, method);
+    if (intf == IntSupplier.class)
+      return new IntGet(handler, method);
+    if (intf == LongSupplier.class)
+      return new LongGet(handler, method);
+    if (intf == DoubleSupplier.class)
+      return new DoubleGet(handler, method);
+    if (intf == BooleanSupplier.class)
+      return new BooleanGet(handler, method);
+    if (intf == IntToLongFunction.class)
+      return new IntToLong(handler, method);
+    if (intf == IntToDoubleFunction.class)
+      return new IntToDouble(handler, method);
+    if (intf == LongToIntFunction.class)
+      return new LongToInt(handler, method);
+    if (intf == LongToDoubleFunction.class)
+      return new LongToDouble(handler, method);
+    if (intf == DoubleToIntFunction.class)
+      return new DoubleToInt(handler, method);
+    if (intf == DoubleToLongFunction.class)
+      return new DoubleToLong(handler, method);
+    if (intf == IntFunction.class)
+      return new IntApply(handler, method);
+    if (intf == LongFunction.class)
+      return new LongApply(handler, method);
+    if (intf == DoubleFunction.class)
+      return new DoubleApply(handler, method);
+    if (intf == ToIntFunction.class)
+      return new ToInt(handler, method);
+    if (intf == ToLongFunction.class)
+      return new ToLong(handler, method);
+    if (intf == ToDoubleFunction.class)
+      return new ToDouble(handler, method);
+    if (intf == ObjIntConsumer.class)
+      return new ObjIntAccept(handler, method);
+    if (intf == ObjLongConsumer.class)
+      return new ObjLongAccept(handler, method);
+    if (intf == ObjDoubleConsumer.class)
+      return new ObjDoubleAccept(handler, method);
+    return null;
+  }
+
+  final long invokeLong(long j0, long j1, double d0, double d1, Object o0)
+  {
+    if (handler.context.isShutdown())
+      throw new RuntimeException("Proxy called during shutdown");
+    return JPypeProxy.hostInvokeLong(handler.context.getContext(), name, index,
+            handler.instance, returnType, parameterTypes, j0, j1, d0, d1, o0);
+  }
+
+  final double invokeDouble(long j0, long j1, double d0, double d1, Object o0)
+  {
+    if (handler.context.isShutdown())
+      throw new RuntimeException("Proxy called during shutdown");
+    return JPypeProxy.hostInvokeDouble(handler.context.getContext(), name, index,
+            handler.instance, returnType, parameterTypes, j0, j1, d0, d1, o0);
+  }
+
+  final Object invokeObject(long j0, long j1, double d0, double d1, Object o0)
+  {
+    if (handler.context.isShutdown())
+      throw new RuntimeException("Proxy called during shutdown");
+    return JPypeProxy.hostInvokeObject(handler.context.getContext(), name, index,
+            handler.instance, returnType, parameterTypes, j0, j1, d0, d1, o0);
+  }
+
+  // Object methods are forwarded to Python just as in a reflection proxy.
+  static final int EQUALS = 0;
+  static final int HASH_CODE = 1;
+  static final int TO_STRING = 2;
+  static final Method[] OBJECT_METHODS;
+
+  static
+  {
+    try
+    {
+      OBJECT_METHODS = new Method[]
+      {
+        Object.class.getMethod("equals", Object.class),
+        Object.class.getMethod("hashCode"),
+        Object.class.getMethod("toString")
+      };
+    } catch (NoSuchMethodException ex)
+    {
+      throw new RuntimeException(ex);
+    }
+  }
+
+  final Object invokeObjectMethod(int id, Object[] args)
+  {
+    if (handler.context.isShutdown())
+      throw new RuntimeException("Proxy called during shutdown");
+    Method method = OBJECT_METHODS[id];
+    JPypeProxy.MethodInfo info = handler.methods.get(method);
+    if (info == null)
+      info = handler.resolve(method);
+    return handler.dispatch(method.getName(), info, args);
+  }
+
+  @Override
+  public boolean equals(Object obj)
+  {
+    return (Boolean) invokeObjectMethod(EQUALS, new Object[]
+    {
+      obj
+    });
+  }
+
+  @Override
+  public int hashCode()
+  {
+    return (Integer) invokeObjectMethod(HASH_CODE, null);
+  }
+
+  @Override
+  public String toString()
+  {
+    return (String) invokeObjectMethod(TO_STRING, null);
+  }
+
+//<editor-fold desc="implementations" defaultstate="collapsed">
+  static final class IntUnary extends JPypePrimitiveProxy implements IntUnaryOperator
+  {
+
+    IntUnary(JPypeProxy handler, Method method)
+    {
+      super(handler, method);
+    }
+
+    @Override
+    public int applyAsInt(int a0)
+    {
+      return (int) invokeLong(a0, 0, 0, 0, null);
+    }
+  }
+
+  static final class IntBinary extends JPypePrimitiveProxy implements IntBinaryOperator
+  {
+
+    IntBinary(JPypeProxy handler, Method method)
+    {
+      super(handler, method);
+    }
+
+    @Override
+    public int applyAsInt(int a0, int a1)
+    {
+      return (int) invokeLong(a0, a1, 0, 0, null);
+    }
+  }
+
+  static final class LongUnary extends JPypePrimitiveProxy implements LongUnaryOperator
+  {
+
+    LongUnary(JPypeProxy handler, Method method)
+    {
+      super(handler, method);
+    }
+
+    @Override
+    public long applyAsLong(long a0)
+    {
+      return invokeLong(a0, 0, 0, 0, null);
+    }
+  }
+
+  static final class LongBinary extends JPypePrimitiveProxy implements LongBinaryOperator
+  {
+
+    LongBinary(JPypeProxy handler, Method method)
+    {
+      super(handler, method);
+    }
+
+    @Override
+    public long applyAsLong(long a0, long a1)
+    {
+      return invokeLong(a0, a1, 0, 0, null);
+    }
+  }
+
+  static final class DoubleUnary extends JPypePrimitiveProxy implements DoubleUnaryOperator
+  {
+
+    DoubleUnary(JPypeProxy handler, Method method)
+    {
+      super(handler, method);
+    }
+
+    @Override
+    public double applyAsDouble(double a0)
+    {
+      return invokeDouble(0, 0, a0, 0, null);
+    }
+  }
+
+  static final class DoubleBinary extends JPypePrimitiveProxy implements DoubleBinaryOperator
+  {
+
+    DoubleBinary(JPypeProxy handler, Method method)
+    {
+      super(handler, method);
+    }
+
+    @Override
+    public double applyAsDouble(double a0, double a1)
+    {
+      return invokeDouble(0, 0, a0, a1, null);
+    }
+  }
+
+  static final class IntTest extends JPypePrimitiveProxy implements IntPredicate
+  {
+
+    IntTest(JPypeProxy handler, Method method)
+    {
+      super(handler, method);
+    }
+
+    @Override
+    public boolean test(int a0)
+    {
+      return invokeLong(a0, 0, 0, 0, null) != 0;
+    }
+  }
+
+  static final class LongTest extends JPypePrimitiveProxy implements LongPredicate
+  {
+
+    LongTest(JPypeProxy handler, Method method)
+    {
+      super(handler, method);
+    }
+
+    @Override
+    public boolean test(long a0)
+    {
+      return invokeLong(a0, 0, 0, 0, null) != 0;
+    }
+  }
+
+  static final class DoubleTest extends JPypePrimitiveProxy implements DoublePredicate
+  {
+
+    DoubleTest(JPypeProxy handler, Method method)
+    {
+      super(handler, method);
+    }
+
+    @Override
+    public boolean test(double a0)
+    {
+      return invokeLong(0, 0, a0, 0, null) != 0;
+    }
+  }
+
+  static final class IntAccept extends JPypePrimitiveProxy implements IntConsumer
+  {
+
+    IntAccept(JPypeProxy handler, Method method)
+    {
+      super(handler, method);
+    }
+
+    @Override
+    public void accept(int a0)
+    {
+      invokeLong(a0, 0, 0, 0, null);
+    }
+  }
+
+  static final class LongAccept extends JPypePrimitiveProxy implements LongConsumer
+  {
+
+    LongAccept(JPypeProxy handler, Method method)
+    {
+      super(handler, method);
+    }
+
+    @Override
+    public void accept(long a0)
+    {
+      invokeLong(a0, 0, 0, 0, null);
+    }
+  }
+
+  static final class DoubleAccept extends JPypePrimitiveProxy implements DoubleConsumer
+  {
+
+    DoubleAccept(JPypeProxy handler, Method method)
+    {
+      super(handler, method);
+    }
+
+    @Override
+    public void accept(double a0)
+    {
+      invokeLong(0, 0, a0, 0, null);
+    }
+  }
+
+  static final class IntGet extends JPypePrimitiveProxy implements IntSupplier
+  {
+
+    IntGet(JPypeProxy handler, Method method)
+    {
+      super(handler, method);
+    }
+
+    @Override
+    public int getAsInt()
+    {
+      return (int) invokeLong(0, 0, 0, 0, null);
+    }
+  }
+
+  static final class LongGet extends JPypePrimitiveProxy implements LongSupplier
+  {
+
+    LongGet(JPypeProxy handler, Method method)
+    {
+      super(handler, method);
+    }
+
+    @Override
+    public long getAsLong()
+    {
+      return invokeLong(0, 0, 0, 0, null);
+    }
+  }
+
+  static final class DoubleGet extends JPypePrimitiveProxy implements DoubleSupplier
+  {
+
+    DoubleGet(JPypeProxy handler, Method method)
+    {
+      super(handler, method);
+    }
+
+    @Override
+    public double getAsDouble()
+    {
+      return invokeDouble(0, 0, 0, 0, null);
+    }
+  }
+
+  static final class BooleanGet extends JPypePrimitiveProxy implements BooleanSupplier
+  {
+
+    BooleanGet(JPypeProxy handler, Method method)
+    {
+      super(handler, method);
+    }
+
+    @Override
+    public boolean getAsBoolean()
+    {
+      return invokeLong(0, 0, 0, 0, null) != 0;
+    }
+  }
+
+  static final class IntToLong extends JPypePrimitiveProxy implements IntToLongFunction
+  {
+
+    IntToLong(JPypeProxy handler, Method method)
+    {
+      super(handler, method);
+    }
+
+    @Override
+    public long applyAsLong(int a0)
+    {
+      return invokeLong(a0, 0, 0, 0, null);
+    }
+  }
+
+  static final class IntToDouble extends JPypePrimitiveProxy implements IntToDoubleFunction
+  {
+
+    IntToDouble(JPypeProxy handler, Method method)
+    {
+      super(handler, method);
+    }
+
+    @Override
+    public double applyAsDouble(int a0)
+    {
+      return invokeDouble(a0, 0, 0, 0, null);
+    }
+  }
+
+  static final class LongToInt extends JPypePrimitiveProxy implements LongToIntFunction
+  {
+
+    LongToInt(JPypeProxy handler, Method method)
+    {
+      super(handler, method);
+    }
+
+    @Override
+    public int applyAsInt(long a0)
+    {
+      return (int) invokeLong(a0, 0, 0, 0, null);
+    }
+  }
+
+  static final class LongToDouble extends JPypePrimitiveProxy implements LongToDoubleFunction
+  {
+
+    LongToDouble(JPypeProxy handler, Method method)
+    {
+      super(handler, method);
+    }
+
+    @Override
+    public double applyAsDouble(long a0)
+    {
+      return invokeDouble(a0, 0, 0, 0, null);
+    }
+  }
+
+  static final class DoubleToInt extends JPypePrimitiveProxy implements DoubleToIntFunction
+  {
+
+    DoubleToInt(JPypeProxy handler, Method method)
+    {
+      super(handler, method);
+    }
+
+    @Override
+    public int applyAsInt(double a0)
+    {
+      return (int) invokeLong(0, 0, a0, 0, null);
+    }
+  }
+
+  static final class DoubleToLong extends JPypePrimitiveProxy implements DoubleToLongFunction
+  {
+
+    DoubleToLong(JPypeProxy handler, Method method)
+    {
+      super(handler, method);
+    }
+
+    @Override
+    public long applyAsLong(double a0)
+    {
+      return invokeLong(0, 0, a0, 0, null);
+    }
+  }
+
+  static final class IntApply extends JPypePrimitiveProxy implements IntFunction
+  {
+
+    IntApply(JPypeProxy handler, Method method)
+    {
+      super(handler, method);
+    }
+
+    @Override
+    public Object apply(int a0)
+    {
+      return invokeObject(a0, 0, 0, 0, null);
+    }
+  }
+
+  static final class LongApply extends JPypePrimitiveProxy implements LongFunction
+  {
+
+    LongApply(JPypeProxy handler, Method method)
+    {
+      super(handler, method);
+    }
+
+    @Override
+    public Object apply(long a0)
+    {
+      return invokeObject(a0, 0, 0, 0, null);
+    }
+  }
+
+  static final class DoubleApply extends JPypePrimitiveProxy implements DoubleFunction
+  {
+
+    DoubleApply(JPypeProxy handler, Method method)
+    {
+      super(handler, method);
+    }
+
+    @Override
+    public Object apply(double a0)
+    {
+      return invokeObject(0, 0, a0, 0, null);
+    }
+  }
+
+  static final class ToInt extends JPypePrimitiveProxy implements ToIntFunction
+  {
+
+    ToInt(JPypeProxy handler, Method method)
+    {
+      super(handler, method);
+    }
+
+    @Override
+    public int applyAsInt(Object a0)
+    {
+      return (int) invokeLong(0, 0, 0, 0, a0);
+    }
+  }
+
+  static final class ToLong extends JPypePrimitiveProxy implements ToLongFunction
+  {
+
+    ToLong(JPypeProxy handler, Method method)
+    {
+      super(handler, method);
+    }
+
+    @Override
+    public long applyAsLong(Object a0)
+    {
+      return invokeLong(0, 0, 0, 0, a0);
+    }
+  }
+
+  static final class ToDouble extends JPypePrimitiveProxy implements ToDoubleFunction
+  {
+
+    ToDouble(JPypeProxy handler, Method method)
+    {
+      super(handler, method);
+    }
+
+    @Override
+    public double applyAsDouble(Object a0)
+    {
+      return invokeDouble(0, 0, 0, 0, a0);
+    }
+  }
+
+  static final class ObjIntAccept extends JPypePrimitiveProxy implements ObjIntConsumer
+  {
+
+    ObjIntAccept(JPypeProxy handler, Method method)
+    {
+      super(handler, method);
+    }
+
+    @Override
+    public void accept(Object a0, int a1)
+    {
+      invokeLong(a1, 0, 0, 0, a0);
+    }
+  }
+
+  static final class ObjLongAccept extends JPypePrimitiveProxy implements ObjLongConsumer
+  {
+
+    ObjLongAccept(JPypeProxy handler, Method method)
+    {
+      super(handler, method);
+    }
+
+    @Override
+    public void accept(Object a0, long a1)
+    {
+      invokeLong(a1, 0, 0, 0, a0);
+    }
+  }
+
+  static final class ObjDoubleAccept extends JPypePrimitiveProxy implements ObjDoubleConsumer
+  {
+
+    ObjDoubleAccept(JPypeProxy handler, Method method)
+    {
+      super(handler, method);
+    }
+
+    @Override
+    public void accept(Object a0, double a1)
+    {
+      invokeLong(0, 0, a1, 0, a0);
+    }
+  }
+//</editor-fold>
+}
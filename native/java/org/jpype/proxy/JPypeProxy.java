@@ -18,6 +18,20 @@ package org.jpype.proxy;
 import java.lang.reflect.InvocationHandler;
 import java.lang.reflect.Method;
 import java.lang.reflect.Proxy;
+import java.util.ArrayDeque;
+import java.util.Arrays;
+import java.util.concurrent.ArrayBlockingQueue;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.CompletionStage;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.ScheduledExecutorService;
+import java.util.concurrent.ThreadFactory;
+import java.util.concurrent.ThreadPoolExecutor;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.atomic.AtomicInteger;
+import java.util.function.BiConsumer;
 import org.jpype.JPypeContext;
 import org.jpype.manager.TypeManager;
 import org.jpype.ref.JPypeReferenceQueue;
@@ -35,14 +49,27 @@ public class JPypeProxy implements InvocationHandler
   public long cleanup;
   Class<?>[] interfaces;
   ClassLoader cl = ClassLoader.getSystemClassLoader();
+  // Queue methods returning void or a future rather than blocking the caller.
+  boolean asynchronous;
+  // Coalesce calls to void methods and deliver them as a list.
+  int batchSize;
+  long batchLatency;
+  // Resolved information for each method that has been called.
+  final ConcurrentHashMap<Method, MethodInfo> methods = new ConcurrentHashMap<>();
 
   public static JPypeProxy newProxy(JPypeContext context,
           long instance,
           long cleanup,
-          Class<?>[] interfaces)
+          Class<?>[] interfaces,
+          boolean asynchronous,
+          int batchSize,
+          long batchLatency)
   {
     JPypeProxy proxy = new JPypeProxy();
     proxy.context = context;
+    proxy.asynchronous = asynchronous;
+    proxy.batchSize = batchSize;
+    proxy.batchLatency = batchLatency;
     proxy.instance = instance;
     proxy.interfaces = interfaces;
     proxy.cleanup = cleanup;
@@ -60,7 +87,13 @@ public class JPypeProxy implements InvocationHandler
 
   public Object newInstance()
   {
-    Object out = Proxy.newProxyInstance(cl, interfaces, this);
+    Object out = null;
+    if (!asynchronous && batchSize == 0)
+      out = JPypePrimitiveProxy.create(this);
+    if (out == null)
+      out = JPypeProxyGenerator.create(this);
+    if (out == null)
+      out = Proxy.newProxyInstance(cl, interfaces, this);
     referenceQueue.registerRef(out, instance, cleanup);
     return out;
   }
@@ -75,29 +108,398 @@ public class JPypeProxy implements InvocationHandler
       if (context.isShutdown())
         throw new RuntimeException("Proxy called during shutdown");
 
-      // We can save a lot of effort on the C++ side by doing all the
-      // type lookup work here.
-      TypeManager typeManager = context.getTypeManager();
-      long returnType;
-      long[] parameterTypes;
-      synchronized (typeManager)
+      MethodInfo info = methods.get(method);
+      if (info == null)
+        info = resolve(method);
+      return dispatch(method.getName(), info, args);
+    } finally
+    {
+//      context.decrementProxy();
+    }
+  }
+
+  /**
+   * Call Python for a resolved method.
+   * <p>
+   * Asynchronous methods are queued to the executor. Methods returning void
+   * return immediately and those returning a future are given a future
+   * which completes when Python returns.
+   *
+   * @param name is the name of the method.
+   * @param info is the resolved method.
+   * @param args are the arguments to the method.
+   * @return the result of the call.
+   */
+  Object dispatch(final String name, final MethodInfo info, final Object[] args)
+  {
+    if (info.mode == MethodInfo.SYNC)
+      return hostInvoke(context.getContext(), name, info.index,
+              instance, info.returnType, info.parameterTypes, args);
+    if (info.mode == MethodInfo.BATCH)
+    {
+      info.batch.add(name, info, args);
+      return null;
+    }
+
+    final CompletableFuture<Object> future = new CompletableFuture<>();
+    getExecutor().execute(new Runnable()
+    {
+      @Override
+      @SuppressWarnings("unchecked")
+      public void run()
       {
-        returnType = typeManager.findClass(method.getReturnType());
-        Class<?>[] types = method.getParameterTypes();
-        parameterTypes = new long[types.length];
-        for (int i = 0; i < types.length; ++i)
+        try
+        {
+          if (context.isShutdown())
+            throw new RuntimeException("Proxy called during shutdown");
+          Object result = hostInvoke(context.getContext(), name, info.index,
+                  instance, info.returnType, info.parameterTypes, args);
+          if (result instanceof CompletionStage)
+            ((CompletionStage<Object>) result).whenComplete(new Completer(future));
+          else
+            future.complete(result);
+        } catch (Throwable th)
         {
-          parameterTypes[i] = typeManager.findClass(types[i]);
+          // Nobody waits on the future of a void method.
+          if (info.mode == MethodInfo.VOID)
+            report(th);
+          else
+            future.completeExceptionally(th);
         }
       }
+    });
+    if (info.mode == MethodInfo.VOID)
+      return null;
+    return future;
+  }
 
-      return hostInvoke(context.getContext(), method.getName(), instance, returnType, parameterTypes, args);
-    } finally
+  private static ExecutorService executor;
+
+  // Workers and queued calls shared by all asynchronous proxies.
+  static final int MAX_WORKERS = 4;
+  static final int MAX_QUEUED = 1024;
+
+  /**
+   * Get the executor for asynchronous proxy calls.
+   * <p>
+   * Each worker holds the GIL only while Python is running, so calls may
+   * complete in any order. The number of workers and queued calls is
+   * bounded. Once the queue is full the calling thread runs the call itself,
+   * which slows the producer rather than growing the queue.
+   */
+  static synchronized ExecutorService getExecutor()
+  {
+    if (executor == null)
     {
-//      context.decrementProxy();
+      ThreadPoolExecutor pool = new ThreadPoolExecutor(MAX_WORKERS, MAX_WORKERS,
+              60, TimeUnit.SECONDS, new ArrayBlockingQueue<Runnable>(MAX_QUEUED),
+              new ThreadFactory()
+      {
+        final AtomicInteger count = new AtomicInteger();
+
+        @Override
+        public Thread newThread(Runnable r)
+        {
+          Thread thread = new Thread(r, "JPype-Proxy-" + count.incrementAndGet());
+          thread.setDaemon(true);
+          return thread;
+        }
+      }, new ThreadPoolExecutor.CallerRunsPolicy());
+      pool.allowCoreThreadTimeOut(true);
+      executor = pool;
+    }
+    return executor;
+  }
+
+  private static ScheduledExecutorService scheduler;
+
+  /**
+   * Get the timer used to deliver batches which have waited too long.
+   */
+  static synchronized ScheduledExecutorService getScheduler()
+  {
+    if (scheduler == null)
+    {
+      scheduler = Executors.newSingleThreadScheduledExecutor(new ThreadFactory()
+      {
+        @Override
+        public Thread newThread(Runnable r)
+        {
+          Thread thread = new Thread(r, "JPype-Proxy-Batch");
+          thread.setDaemon(true);
+          return thread;
+        }
+      });
     }
+    return scheduler;
   }
 
-  private static native Object hostInvoke(long context, String name, long pyObject,
-          long returnType, long[] argsTypes, Object[] args);
+  /**
+   * Report an error from a call which has no caller to receive it.
+   *
+   * @param th is the error.
+   */
+  static void report(Throwable th)
+  {
+    Thread thread = Thread.currentThread();
+    thread.getUncaughtExceptionHandler().uncaughtException(thread, th);
+  }
+
+  /**
+   * Calls to a void method waiting to be delivered to Python.
+   * <p>
+   * A batch is delivered when it is full or when the oldest call has waited
+   * for the latency. Full batches are delivered on the calling thread, which
+   * bounds the queue, unless the proxy is also asynchronous. Asynchronous
+   * proxies hand full batches to a worker until MAX_READY are waiting, after
+   * which the caller delivers them itself.
+   */
+  class Batch
+  {
+
+    static final int MAX_READY = 8;
+
+    Object[][] calls = new Object[batchSize][];
+    int count;
+    // Batches waiting to be delivered, oldest first.
+    final ArrayDeque<Object[][]> ready = new ArrayDeque<>();
+    // Set while a worker is delivering the ready batches.
+    boolean draining;
+    // Held while delivering so that batches arrive in order.
+    final Object deliver = new Object();
+
+    void add(final String name, final MethodInfo info, Object[] args)
+    {
+      boolean first;
+      boolean drain = false;
+      boolean submit = false;
+      synchronized (this)
+      {
+        first = (count == 0);
+        calls[count++] = (args == null) ? new Object[0] : args;
+        if (count == calls.length)
+        {
+          ready.add(calls);
+          calls = new Object[batchSize][];
+          count = 0;
+          if (!asynchronous || ready.size() > MAX_READY)
+            drain = true;
+          else if (!draining)
+            draining = submit = true;
+        }
+      }
+      if (drain)
+        deliver(name, info);
+      else if (submit)
+      {
+        getExecutor().execute(new Runnable()
+        {
+          @Override
+          public void run()
+          {
+            while (true)
+            {
+              synchronized (Batch.this)
+              {
+                if (ready.isEmpty())
+                {
+                  draining = false;
+                  return;
+                }
+              }
+              try
+              {
+                deliver(name, info);
+              } catch (Throwable th)
+              {
+                report(th);
+              }
+            }
+          }
+        });
+      } else if (first)
+      {
+        getScheduler().schedule(new Runnable()
+        {
+          @Override
+          public void run()
+          {
+            try
+            {
+              flush(name, info);
+            } catch (Throwable th)
+            {
+              report(th);
+            }
+          }
+        }, batchLatency, TimeUnit.NANOSECONDS);
+      }
+    }
+
+    void flush(String name, MethodInfo info)
+    {
+      synchronized (this)
+      {
+        if (count > 0)
+        {
+          ready.add(Arrays.copyOf(calls, count));
+          calls = new Object[batchSize][];
+          count = 0;
+        }
+      }
+      deliver(name, info);
+    }
+
+    /**
+     * Deliver the ready batches in the order they were filled.
+     */
+    void deliver(String name, MethodInfo info)
+    {
+      synchronized (deliver)
+      {
+        while (true)
+        {
+          Object[][] pending;
+          synchronized (this)
+          {
+            pending = ready.poll();
+          }
+          if (pending == null)
+            return;
+          if (context.isShutdown())
+            throw new RuntimeException("Proxy called during shutdown");
+          hostInvokeBatch(context.getContext(), name, info.index,
+                  instance, info.returnType, info.parameterTypes, pending, pending.length);
+        }
+      }
+    }
+  }
+
+  static class Completer implements BiConsumer<Object, Throwable>
+  {
+
+    final CompletableFuture<Object> future;
+
+    Completer(CompletableFuture<Object> future)
+    {
+      this.future = future;
+    }
+
+    @Override
+    public void accept(Object result, Throwable th)
+    {
+      if (th != null)
+        future.completeExceptionally(th);
+      else
+        future.complete(result);
+    }
+  }
+
+  /**
+   * Get the handler for a proxy instance.
+   *
+   * @param obj is a proxy created by this handler.
+   * @return the handler.
+   */
+  public static JPypeProxy getHandler(Object obj)
+  {
+    if (obj instanceof JPypePrimitiveProxy)
+      return ((JPypePrimitiveProxy) obj).handler;
+    if (obj instanceof JPypeGeneratedProxy)
+      return ((JPypeGeneratedProxy) obj).handler;
+    return (JPypeProxy) Proxy.getInvocationHandler(obj);
+  }
+
+  /**
+   * Check if an object is a proxy to Python.
+   *
+   * @param obj is the object to check.
+   * @return true if the object was created by a JPypeProxy.
+   */
+  public static boolean isProxy(Object obj)
+  {
+    if (obj instanceof JPypePrimitiveProxy || obj instanceof JPypeGeneratedProxy)
+      return true;
+    return Proxy.isProxyClass(obj.getClass())
+            && (Proxy.getInvocationHandler(obj) instanceof JPypeProxy);
+  }
+
+  /**
+   * Get the information needed to call a method.
+   * <p>
+   * We can save a lot of effort on the C++ side by doing all the type lookup
+   * work here. Each method is assigned an index when it is first called so
+   * that the native side can cache the Python callable.
+   *
+   * @param method is the method being called.
+   * @return the information for the method.
+   */
+  synchronized MethodInfo resolve(Method method)
+  {
+    MethodInfo info = methods.get(method);
+    if (info != null)
+      return info;
+    info = new MethodInfo();
+    info.index = methods.size();
+    Class<?> returnType = method.getReturnType();
+    if (batchSize > 0 && returnType == Void.TYPE)
+    {
+      info.mode = MethodInfo.BATCH;
+      info.batch = new Batch();
+    } else if (asynchronous && returnType == Void.TYPE)
+      info.mode = MethodInfo.VOID;
+    else if (asynchronous && returnType != Object.class
+            && returnType.isAssignableFrom(CompletableFuture.class))
+    {
+      // Python may return either the value or a future.
+      info.mode = MethodInfo.FUTURE;
+      returnType = Object.class;
+    }
+    TypeManager typeManager = context.getTypeManager();
+    synchronized (typeManager)
+    {
+      info.returnType = typeManager.findClass(returnType);
+      Class<?>[] types = method.getParameterTypes();
+      info.parameterTypes = new long[types.length];
+      for (int i = 0; i < types.length; ++i)
+      {
+        info.parameterTypes[i] = typeManager.findClass(types[i]);
+      }
+    }
+    methods.put(method, info);
+    return info;
+  }
+
+  static class MethodInfo
+  {
+
+    final static int SYNC = 0;
+    final static int VOID = 1;
+    final static int FUTURE = 2;
+    final static int BATCH = 3;
+    int mode = SYNC;
+    Batch batch;
+    int index;
+    long returnType;
+    long[] parameterTypes;
+  }
+
+  static native Object hostInvoke(long context, String name, int index,
+          long pyObject, long returnType, long[] argsTypes, Object[] args);
+
+  private static native void hostInvokeBatch(long context, String name, int index,
+          long pyObject, long returnType, long[] argsTypes, Object[][] calls, int count);
+
+  // Entry points for JPypePrimitiveProxy which pass the arguments unboxed.
+  static native long hostInvokeLong(long context, String name, int index,
+          long pyObject, long returnType, long[] argsTypes,
+          long j0, long j1, double d0, double d1, Object o0);
+
+  static native double hostInvokeDouble(long context, String name, int index,
+          long pyObject, long returnType, long[] argsTypes,
+          long j0, long j1, double d0, double d1, Object o0);
+
+  static native Object hostInvokeObject(long context, String name, int index,
+          long pyObject, long returnType, long[] argsTypes,
+          long j0, long j1, double d0, double d1, Object o0);
 }
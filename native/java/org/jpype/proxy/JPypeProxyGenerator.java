@@ -0,0 +1,546 @@
+/* ****************************************************************************
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  See NOTICE file for details.
+**************************************************************************** */
+package org.jpype.proxy;
+
+import java.io.ByteArrayOutputStream;
+import java.io.DataOutputStream;
+import java.io.IOException;
+import java.lang.reflect.Constructor;
+import java.lang.reflect.Method;
+import java.lang.reflect.Modifier;
+import java.util.Arrays;
+import java.util.HashMap;
+import java.util.LinkedHashMap;
+import java.util.List;
+import java.util.Map;
+import java.util.concurrent.atomic.AtomicInteger;
+
+/**
+ * (internal) Generates concrete proxy classes for a set of interfaces.
+ * <p>
+ * This is enabled by starting the JVM with
+ * {@code -Dorg.jpype.proxy.generate=true}. The generated class extends
+ * JPypeGeneratedProxy and implements every interface method by packing the
+ * arguments and calling into Python directly, which lets the JIT inline the
+ * Java side of the callback. Interface sets that cannot be generated, such as
+ * those with non-public interfaces, fall back to java.lang.reflect.Proxy.
+ */
+public class JPypeProxyGenerator
+{
+
+  static final boolean ENABLED = Boolean.getBoolean("org.jpype.proxy.generate");
+  private static final String BASE = "org/jpype/proxy/JPypeGeneratedProxy";
+  private static final String BASE_INIT = "(Lorg/jpype/proxy/JPypeProxy;[Ljava/lang/reflect/Method;)V";
+  private static final AtomicInteger COUNTER = new AtomicInteger();
+  // Generated classes by interface set, null if generation failed.  The sets
+  // are held by one of their interfaces so that unloading it frees them.
+  private static final ClassValue<Map<List<Class<?>>, Generated>> CACHE
+          = new ClassValue<Map<List<Class<?>>, Generated>>()
+  {
+    @Override
+    protected Map<List<Class<?>>, Generated> computeValue(Class<?> type)
+    {
+      return new HashMap<>();
+    }
+  };
+
+  /**
+   * Create a generated proxy if enabled.
+   *
+   * @param handler is the handler for the proxy.
+   * @return the proxy instance or null if the interfaces are not supported.
+   */
+  static Object create(JPypeProxy handler)
+  {
+    if (!ENABLED)
+      return null;
+    try
+    {
+      Generated generated = getGenerated(handler.cl, handler.interfaces);
+      if (generated == null)
+        return null;
+      return generated.ctor.newInstance(handler, generated.methods);
+    } catch (ReflectiveOperationException ex)
+    {
+      return null;
+    }
+  }
+
+  static synchronized Generated getGenerated(ClassLoader cl, Class<?>[] interfaces)
+  {
+    List<Class<?>> key = Arrays.asList(interfaces);
+    // Use an interface from the loader the class is defined in, as the
+    // generated class can see every interface visible to that loader.
+    Class<?> owner = interfaces[0];
+    for (Class<?> intf : interfaces)
+    {
+      if (intf.getClassLoader() == cl)
+        owner = intf;
+    }
+    Map<List<Class<?>>, Generated> cache = CACHE.get(owner);
+    if (cache.containsKey(key))
+      return cache.get(key);
+    Generated generated = null;
+    try
+    {
+      Method[] methods = collectMethods(interfaces);
+      if (methods != null)
+      {
+        String name = "org/jpype/proxy/$JPypeProxy$" + COUNTER.incrementAndGet();
+        byte[] data = generate(name, interfaces, methods);
+        Class<?> cls = new Loader(cl).define(name.replace('/', '.'), data);
+        generated = new Generated();
+        generated.ctor = cls.getConstructor(JPypeProxy.class, Method[].class);
+        generated.methods = methods;
+      }
+    } catch (Throwable th)
+    {
+      // Fall back to the reflection proxy.
+      generated = null;
+    }
+    cache.put(key, generated);
+    return generated;
+  }
+
+  static class Generated
+  {
+
+    Constructor<?> ctor;
+    Method[] methods;
+  }
+
+  /**
+   * Get the methods to implement.
+   *
+   * @param interfaces are the interfaces to implement.
+   * @return the methods, or null if the interfaces are not supported.
+   */
+  static Method[] collectMethods(Class<?>[] interfaces) throws NoSuchMethodException
+  {
+    LinkedHashMap<String, Method> out = new LinkedHashMap<>();
+
+    // Object methods are forwarded to Python just as in a reflection proxy.
+    for (Method m : new Method[]
+    {
+      Object.class.getMethod("equals", Object.class),
+      Object.class.getMethod("hashCode"),
+      Object.class.getMethod("toString")
+    })
+    {
+      out.put(m.getName() + getDescriptor(m), m);
+    }
+
+    for (Class<?> intf : interfaces)
+    {
+      if (!intf.isInterface() || !Modifier.isPublic(intf.getModifiers()))
+        return null;
+      for (Method m : intf.getMethods())
+      {
+        if (Modifier.isStatic(m.getModifiers()))
+          continue;
+        String params = m.getName() + getParameterDescriptor(m);
+        Method prev = out.get(params + getDescriptor(m.getReturnType()));
+        if (prev != null)
+          continue;
+        // Methods which differ only by return type cannot be implemented.
+        for (Method other : out.values())
+        {
+          if ((other.getName() + getParameterDescriptor(other)).equals(params))
+            return null;
+        }
+        out.put(params + getDescriptor(m.getReturnType()), m);
+      }
+    }
+    return out.values().toArray(new Method[out.size()]);
+  }
+
+//<editor-fold desc="class file" defaultstate="collapsed">
+  static byte[] generate(String name, Class<?>[] interfaces, Method[] methods) throws IOException
+  {
+    ConstantPool pool = new ConstantPool();
+    int thisClass = pool.addClass(name);
+    int superClass = pool.addClass(BASE);
+    int[] interfaceIds = new int[interfaces.length];
+    for (int i = 0; i < interfaces.length; ++i)
+    {
+      interfaceIds[i] = pool.addClass(getInternalName(interfaces[i]));
+    }
+    int codeName = pool.addUtf8("Code");
+
+    ByteArrayOutputStream methodBytes = new ByteArrayOutputStream();
+    DataOutputStream mout = new DataOutputStream(methodBytes);
+
+    // Constructor passes everything to the base
+    {
+      ByteArrayOutputStream code = new ByteArrayOutputStream();
+      code.write(ALOAD_0);
+      code.write(ALOAD_1);
+      code.write(ALOAD_2);
+      writeOp(code, INVOKESPECIAL, pool.addMethod(BASE, "<init>", BASE_INIT));
+      code.write(RETURN);
+      writeMethod(mout, pool, ACC_PUBLIC, "<init>", BASE_INIT, codeName, 3, 3, code.toByteArray());
+    }
+
+    int invokeHost = pool.addMethod(BASE, "invokeHost", "(I[Ljava/lang/Object;)Ljava/lang/Object;");
+    int objectClass = pool.addClass("java/lang/Object");
+    for (int id = 0; id < methods.length; ++id)
+    {
+      Method m = methods[id];
+      Class<?>[] params = m.getParameterTypes();
+      ByteArrayOutputStream code = new ByteArrayOutputStream();
+
+      // this.invokeHost(id, new Object[]{args...})
+      code.write(ALOAD_0);
+      writeInt(code, pool, id);
+      writeInt(code, pool, params.length);
+      writeOp(code, ANEWARRAY, objectClass);
+      int slot = 1;
+      for (int i = 0; i < params.length; ++i)
+      {
+        Class<?> p = params[i];
+        code.write(DUP);
+        writeInt(code, pool, i);
+        if (slot > 255)
+          throw new IOException("Too many parameters");
+        code.write(getLoad(p));
+        code.write(slot);
+        slot += (p == Long.TYPE || p == Double.TYPE) ? 2 : 1;
+        if (p.isPrimitive())
+        {
+          String box = getInternalName(getBox(p));
+          writeOp(code, INVOKESTATIC, pool.addMethod(box, "valueOf",
+                  "(" + getDescriptor(p) + ")L" + box + ";"));
+        }
+        code.write(AASTORE);
+      }
+      writeOp(code, INVOKEVIRTUAL, invokeHost);
+
+      // Return the result
+      Class<?> ret = m.getReturnType();
+      if (ret == Void.TYPE)
+      {
+        code.write(POP);
+        code.write(RETURN);
+      } else if (ret.isPrimitive())
+      {
+        String box = getInternalName(getBox(ret));
+        writeOp(code, CHECKCAST, pool.addClass(box));
+        writeOp(code, INVOKEVIRTUAL, pool.addMethod(box, ret.getName() + "Value",
+                "()" + getDescriptor(ret)));
+        code.write(getReturn(ret));
+      } else
+      {
+        if (ret != Object.class)
+          writeOp(code, CHECKCAST, pool.addClass(getInternalName(ret)));
+        code.write(ARETURN);
+      }
+      writeMethod(mout, pool, ACC_PUBLIC | ACC_FINAL, m.getName(), getDescriptor(m), codeName,
+              8, slot, code.toByteArray());
+    }
+
+    // Assemble the class
+    ByteArrayOutputStream bytes = new ByteArrayOutputStream();
+    DataOutputStream out = new DataOutputStream(bytes);
+    out.writeInt(0xCAFEBABE);
+    out.writeShort(0);
+    out.writeShort(52);
+    pool.write(out);
+    out.writeShort(ACC_PUBLIC | ACC_FINAL | ACC_SUPER);
+    out.writeShort(thisClass);
+    out.writeShort(superClass);
+    out.writeShort(interfaceIds.length);
+    for (int i : interfaceIds)
+    {
+      out.writeShort(i);
+    }
+    out.writeShort(0);
+    out.writeShort(methods.length + 1);
+    mout.flush();
+    out.write(methodBytes.toByteArray());
+    out.writeShort(0);
+    out.flush();
+    return bytes.toByteArray();
+  }
+
+  private static void writeMethod(DataOutputStream out, ConstantPool pool,
+          int access, String name, String desc, int codeName,
+          int maxStack, int maxLocals, byte[] code) throws IOException
+  {
+    out.writeShort(access);
+    out.writeShort(pool.addUtf8(name));
+    out.writeShort(pool.addUtf8(desc));
+    out.writeShort(1);
+    out.writeShort(codeName);
+    out.writeInt(12 + code.length);
+    out.writeShort(maxStack);
+    out.writeShort(maxLocals);
+    out.writeInt(code.length);
+    out.write(code);
+    out.writeShort(0);
+    out.writeShort(0);
+  }
+
+  private static void writeOp(ByteArrayOutputStream code, int op, int index)
+  {
+    code.write(op);
+    code.write(index >> 8);
+    code.write(index & 0xff);
+  }
+
+  private static void writeInt(ByteArrayOutputStream code, ConstantPool pool, int value)
+          throws IOException
+  {
+    if (value <= 5)
+      code.write(ICONST_0 + value);
+    else if (value < 128)
+    {
+      code.write(BIPUSH);
+      code.write(value);
+    } else if (value < 32768)
+    {
+      code.write(SIPUSH);
+      code.write(value >> 8);
+      code.write(value & 0xff);
+    } else
+      writeOp(code, LDC_W, pool.addInteger(value));
+  }
+
+  static String getInternalName(Class<?> cls)
+  {
+    if (cls.isArray())
+      return getDescriptor(cls);
+    return cls.getName().replace('.', '/');
+  }
+
+  static String getDescriptor(Class<?> cls)
+  {
+    if (cls.isArray())
+      return cls.getName().replace('.', '/');
+    if (cls == Void.TYPE)
+      return "V";
+    if (cls == Boolean.TYPE)
+      return "Z";
+    if (cls == Byte.TYPE)
+      return "B";
+    if (cls == Character.TYPE)
+      return "C";
+    if (cls == Short.TYPE)
+      return "S";
+    if (cls == Integer.TYPE)
+      return "I";
+    if (cls == Long.TYPE)
+      return "J";
+    if (cls == Float.TYPE)
+      return "F";
+    if (cls == Double.TYPE)
+      return "D";
+    return "L" + getInternalName(cls) + ";";
+  }
+
+  static String getParameterDescriptor(Method m)
+  {
+    StringBuilder sb = new StringBuilder("(");
+    for (Class<?> p : m.getParameterTypes())
+    {
+      sb.append(getDescriptor(p));
+    }
+    return sb.append(")").toString();
+  }
+
+  static String getDescriptor(Method m)
+  {
+    return getParameterDescriptor(m) + getDescriptor(m.getReturnType());
+  }
+
+  static Class<?> getBox(Class<?> cls)
+  {
+    if (cls == Boolean.TYPE)
+      return Boolean.class;
+    if (cls == Byte.TYPE)
+      return Byte.class;
+    if (cls == Character.TYPE)
+      return Character.class;
+    if (cls == Short.TYPE)
+      return Short.class;
+    if (cls == Integer.TYPE)
+      return Integer.class;
+    if (cls == Long.TYPE)
+      return Long.class;
+    if (cls == Float.TYPE)
+      return Float.class;
+    return Double.class;
+  }
+
+  static int getLoad(Class<?> cls)
+  {
+    if (!cls.isPrimitive())
+      return ALOAD;
+    if (cls == Long.TYPE)
+      return LLOAD;
+    if (cls == Float.TYPE)
+      return FLOAD;
+    if (cls == Double.TYPE)
+      return DLOAD;
+    return ILOAD;
+  }
+
+  static int getReturn(Class<?> cls)
+  {
+    if (cls == Long.TYPE)
+      return LRETURN;
+    if (cls == Float.TYPE)
+      return FRETURN;
+    if (cls == Double.TYPE)
+      return DRETURN;
+    return IRETURN;
+  }
+
+  static final int ACC_PUBLIC = 0x0001;
+  static final int ACC_FINAL = 0x0010;
+  static final int ACC_SUPER = 0x0020;
+
+  static final int ICONST_0 = 0x03;
+  static final int BIPUSH = 0x10;
+  static final int SIPUSH = 0x11;
+  static final int LDC_W = 0x13;
+  static final int ILOAD = 0x15;
+  static final int LLOAD = 0x16;
+  static final int FLOAD = 0x17;
+  static final int DLOAD = 0x18;
+  static final int ALOAD = 0x19;
+  static final int ALOAD_0 = 0x2a;
+  static final int ALOAD_1 = 0x2b;
+  static final int ALOAD_2 = 0x2c;
+  static final int AASTORE = 0x53;
+  static final int POP = 0x57;
+  static final int DUP = 0x59;
+  static final int IRETURN = 0xac;
+  static final int LRETURN = 0xad;
+  static final int FRETURN = 0xae;
+  static final int DRETURN = 0xaf;
+  static final int ARETURN = 0xb0;
+  static final int RETURN = 0xb1;
+  static final int INVOKEVIRTUAL = 0xb6;
+  static final int INVOKESPECIAL = 0xb7;
+  static final int INVOKESTATIC = 0xb8;
+  static final int ANEWARRAY = 0xbd;
+  static final int CHECKCAST = 0xc0;
+
+  /**
+   * Minimal constant pool for the class writer.
+   */
+  static class ConstantPool
+  {
+
+    final ByteArrayOutputStream bytes = new ByteArrayOutputStream();
+    final DataOutputStream out = new DataOutputStream(bytes);
+    final HashMap<String, Integer> entries = new HashMap<>();
+    int count = 1;
+
+    int addUtf8(String s) throws IOException
+    {
+      Integer i = entries.get("U" + s);
+      if (i != null)
+        return i;
+      out.writeByte(1);
+      out.writeUTF(s);
+      entries.put("U" + s, count);
+      return count++;
+    }
+
+    int addInteger(int value) throws IOException
+    {
+      Integer i = entries.get("I" + value);
+      if (i != null)
+        return i;
+      out.writeByte(3);
+      out.writeInt(value);
+      entries.put("I" + value, count);
+      return count++;
+    }
+
+    int addClass(String name) throws IOException
+    {
+      Integer i = entries.get("C" + name);
+      if (i != null)
+        return i;
+      int n = addUtf8(name);
+      out.writeByte(7);
+      out.writeShort(n);
+      entries.put("C" + name, count);
+      return count++;
+    }
+
+    int addMethod(String owner, String name, String desc) throws IOException
+    {
+      String key = "M" + owner + "." + name + desc;
+      Integer i = entries.get(key);
+      if (i != null)
+        return i;
+      int c = addClass(owner);
+      int n = addUtf8(name);
+      int d = addUtf8(desc);
+      out.writeByte(12);
+      out.writeShort(n);
+      out.writeShort(d);
+      int nat = count++;
+      out.writeByte(10);
+      out.writeShort(c);
+      out.writeShort(nat);
+      entries.put(key, count);
+      return count++;
+    }
+
+    void write(DataOutputStream dest) throws IOException
+    {
+      out.flush();
+      dest.writeShort(count);
+      dest.write(bytes.toByteArray());
+    }
+  }
+
+  /**
+   * Loader for generated classes.
+   * <p>
+   * Interfaces are resolved from the loader that can see them while JPype
+   * classes come from the loader that holds JPype.
+   */
+  static class Loader extends ClassLoader
+  {
+
+    Loader(ClassLoader parent)
+    {
+      super(parent);
+    }
+
+    Class<?> define(String name, byte[] data)
+    {
+      return defineClass(name, data, 0, data.length);
+    }
+
+    @Override
+    protected Class<?> loadClass(String name, boolean resolve) throws ClassNotFoundException
+    {
+      Class<?> cls = findLoadedClass(name);
+      if (cls != null)
+        return cls;
+      if (name.startsWith("org.jpype."))
+        return Class.forName(name, false, JPypeProxy.class.getClassLoader());
+      return super.loadClass(name, resolve);
+    }
+  }
+//</editor-fold>
+}
@@ -26,6 +26,8 @@ class JPypeReference extends PhantomReference
 
   long hostReference;
   long cleanup;
+  // Fixed when created so that it can be read without holding a lock.
+  final int stripe;
   int pool;
   int index;
 
@@ -34,6 +36,7 @@ class JPypeReference extends PhantomReference
     super(javaObject, arg1);
     this.hostReference = host;
     this.cleanup = cleanup;
+    this.stripe = JPypeReferenceSet.stripeOf(Thread.currentThread());
   }
 
   @Override
@@ -17,6 +17,17 @@ public class JPypeReferenceNative
    */
   public static native void removeHostReference(long host, long cleanup);
 
+  /**
+   * Native hook to delete a batch of native resources.
+   * <p>
+   * This holds the GIL once for the whole batch.
+   *
+   * @param hosts are the addresses of memory in C.
+   * @param cleanups are the addresses of the functions to cleanup the memory.
+   * @param count is the number of entries to use from the arrays.
+   */
+  public static native void removeHostReferences(long[] hosts, long[] cleanups, int count);
+
   /**
    * Triggered by the sentinel when a GC starts.
    */
@@ -26,8 +37,9 @@ public class JPypeReferenceNative
    * Initialize resources.
    *
    * @param self
-   * @param m
+   * @param m is the method to register a single reference.
+   * @param batch is the method to register a batch of references.
    */
-  public static native void init(Object self, Method m);
+  public static native void init(Object self, Method m, Method batch);
 
 }
@@ -33,6 +33,7 @@ final public class JPypeReferenceQueue extends ReferenceQueue
 {
 
   private final static JPypeReferenceQueue INSTANCE = new JPypeReferenceQueue();
+  final static int BATCH_SIZE = 1024;
   private JPypeReferenceSet hostReferences;
   private boolean isStopped = false;
   private Thread queueThread;
@@ -52,7 +53,9 @@ final public class JPypeReferenceQueue extends ReferenceQueue
     JPypeReferenceNative.removeHostReference(0, 0);
     try
     {
-      JPypeReferenceNative.init(this, getClass().getDeclaredMethod("registerRef", Object.class, Long.TYPE, Long.TYPE));
+      JPypeReferenceNative.init(this,
+              getClass().getDeclaredMethod("registerRef", Object.class, Long.TYPE, Long.TYPE),
+              getClass().getDeclaredMethod("registerRefs", Object[].class, long[].class, long[].class));
     } catch (NoSuchMethodException | SecurityException ex)
     {
       throw new RuntimeException(ex);
@@ -84,6 +87,25 @@ final public class JPypeReferenceQueue extends ReferenceQueue
     }
   }
 
+  /**
+   * (internal) Binds the lifetime of a batch of Python objects.
+   * <p>
+   * Registrations from native are staged and delivered together so that only
+   * one call into Java is required for many references.
+   *
+   * @param javaObjects are the objects to bind the lifespan to.
+   * @param hosts are the pointers to the host objects.
+   * @param cleanups are the pointers to the functions to call to delete the
+   * resources.
+   */
+  public void registerRefs(Object[] javaObjects, long[] hosts, long[] cleanups)
+  {
+    for (int i = 0; i < javaObjects.length; ++i)
+    {
+      registerRef(javaObjects[i], hosts[i], cleanups[i]);
+    }
+  }
+
   /**
    * Start the threading queue.
    */
@@ -151,6 +173,11 @@ final public class JPypeReferenceQueue extends ReferenceQueue
   private class Worker implements Runnable
   {
 
+    // Storage for references to be released together
+    final long[] hosts = new long[BATCH_SIZE];
+    final long[] cleanups = new long[BATCH_SIZE];
+    int count;
+
     @Override
     public void run()
     {
@@ -161,19 +188,27 @@ final public class JPypeReferenceQueue extends ReferenceQueue
           // Check if a ref has been queued. and check if the thread has been
           // stopped every 0.25 seconds
           JPypeReference ref = (JPypeReference) remove(250);
-          if (ref == sentinel)
-          {
-            addSentinel();
-            JPypeReferenceNative.wake();
-            continue;
-          }
-          if (ref != null)
+
+          // Drain anything else that is waiting so that we can release
+          // them with a single call.
+          while (ref != null)
           {
-            long hostRef = ref.hostReference;
-            long cleanup = ref.cleanup;
-            hostReferences.remove(ref);
-            JPypeReferenceNative.removeHostReference(hostRef, cleanup);
+            if (ref == sentinel)
+            {
+              addSentinel();
+              release();
+              JPypeReferenceNative.wake();
+            } else
+            {
+              hosts[count] = ref.hostReference;
+              cleanups[count] = ref.cleanup;
+              hostReferences.remove(ref);
+              if (++count == BATCH_SIZE)
+                release();
+            }
+            ref = (JPypeReference) poll();
           }
+          release();
         } catch (InterruptedException ex)
         {
           // don't know why ... don't really care ...
@@ -185,6 +220,17 @@ final public class JPypeReferenceQueue extends ReferenceQueue
         queueStopMutex.notifyAll();
       }
     }
+
+    /**
+     * Release the collected references.
+     */
+    void release()
+    {
+      if (count == 0)
+        return;
+      JPypeReferenceNative.removeHostReferences(hosts, cleanups, count);
+      count = 0;
+    }
   }
 
   final void addSentinel()
@@ -16,8 +16,15 @@
 package org.jpype.ref;
 
 import java.util.ArrayList;
+import java.util.concurrent.atomic.AtomicInteger;
 
 /**
+ * Set of live references.
+ * <p>
+ * The set is divided into stripes each with its own lock so that threads
+ * registering references do not contend with each other or with the queue
+ * thread removing them. Each stripe holds preallocated pools of slots, thus
+ * adding and removing a reference does not allocate.
  *
  * @author nelson85
  */
@@ -25,17 +32,32 @@ public class JPypeReferenceSet
 {
 
   static final int SIZE = 256;
-  ArrayList<Pool> pools = new ArrayList<>();
-  Pool current;
-  private int items;
+  static final int STRIPES = 16;
+  final Stripe[] stripes = new Stripe[STRIPES];
+  private final AtomicInteger items = new AtomicInteger();
 
   JPypeReferenceSet()
   {
+    for (int i = 0; i < STRIPES; ++i)
+    {
+      stripes[i] = new Stripe(i);
+    }
   }
 
   int size()
   {
-    return items;
+    return items.get();
+  }
+
+  /**
+   * Get the stripe used by a thread.
+   *
+   * @param thread is the thread adding references.
+   * @return the index of the stripe.
+   */
+  static int stripeOf(Thread thread)
+  {
+    return (int) (thread.getId() & (STRIPES - 1));
   }
 
   /**
@@ -45,33 +67,18 @@ public class JPypeReferenceSet
    *
    * @param ref
    */
-  synchronized void add(JPypeReference ref)
+  void add(JPypeReference ref)
   {
     if (ref.cleanup == 0)
       return;
 
-    this.items++;
-    if (current == null)
-    {
-      current = new Pool(pools.size());
-      pools.add(current);
-    }
-
-    if (current.add(ref))
+    // Each thread works on its own stripe
+    Stripe stripe = stripes[ref.stripe];
+    synchronized (stripe)
     {
-      // It is full
-      current = null;
-
-      // Find a free pool
-      for (Pool pool : pools)
-      {
-        if (pool.tail < SIZE)
-        {
-          current = pool;
-          return;
-        }
-      }
+      stripe.add(ref);
     }
+    items.incrementAndGet();
   }
 
   /**
@@ -79,14 +86,18 @@ public class JPypeReferenceSet
    *
    * @param ref
    */
-  synchronized void remove(JPypeReference ref)
+  void remove(JPypeReference ref)
   {
-    if (ref.cleanup == 0)
-      return;
-    pools.get(ref.pool).remove(ref);
-    this.items--;
-    ref.cleanup = 0;
-    ref.pool = -1;
+    Stripe stripe = stripes[ref.stripe];
+    synchronized (stripe)
+    {
+      if (ref.cleanup == 0)
+        return;
+      stripe.remove(ref);
+      ref.cleanup = 0;
+      ref.pool = -1;
+    }
+    items.decrementAndGet();
   }
 
   /**
@@ -98,32 +109,111 @@ public class JPypeReferenceSet
    */
   void flush()
   {
-    for (Pool pool : pools)
+    long[] hosts = new long[JPypeReferenceQueue.BATCH_SIZE];
+    long[] cleanups = new long[JPypeReferenceQueue.BATCH_SIZE];
+    int count = 0;
+    for (Stripe stripe : stripes)
     {
-      for (int i = 0; i < pool.tail; ++i)
+      synchronized (stripe)
       {
-        JPypeReference ref = pool.entries[i];
-        long hostRef = ref.hostReference;
-        long cleanup = ref.cleanup;
-        // This is a sanity check to prevent calling a cleanup with a null
-        // pointer, it would only occur if we failed to manage a deleted
-        // item.
-        if (cleanup == 0)
-          continue;
-        ref.cleanup = 0;
-        JPypeReferenceNative.removeHostReference(hostRef, cleanup);
+        for (Pool pool : stripe.pools)
+        {
+          for (int i = 0; i < pool.tail; ++i)
+          {
+            JPypeReference ref = pool.entries[i];
+            long hostRef = ref.hostReference;
+            long cleanup = ref.cleanup;
+            // This is a sanity check to prevent calling a cleanup with a null
+            // pointer, it would only occur if we failed to manage a deleted
+            // item.
+            if (cleanup == 0)
+              continue;
+            ref.cleanup = 0;
+            hosts[count] = hostRef;
+            cleanups[count] = cleanup;
+            if (++count == hosts.length)
+            {
+              JPypeReferenceNative.removeHostReferences(hosts, cleanups, count);
+              count = 0;
+            }
+          }
+          pool.tail = 0;
+        }
       }
-      pool.tail = 0;
     }
+    if (count > 0)
+      JPypeReferenceNative.removeHostReferences(hosts, cleanups, count);
+    items.set(0);
   }
 
 //<editor-fold desc="internal" defaultstate="collapsed">
+  /**
+   * Portion of the set guarded by a single lock.
+   */
+  static class Stripe
+  {
+
+    final int id;
+    final ArrayList<Pool> pools = new ArrayList<>();
+    Pool current;
+    // Pools which have free slots that are not the current pool
+    Pool free;
+
+    Stripe(int id)
+    {
+      this.id = id;
+      current = new Pool(0);
+      pools.add(current);
+    }
+
+    void add(JPypeReference ref)
+    {
+      if (current == null)
+      {
+        // Reuse a pool with free space before allocating a new one
+        if (free != null)
+        {
+          current = free;
+          free = current.nextFree;
+          current.nextFree = null;
+          current.isFree = false;
+        } else
+        {
+          current = new Pool(pools.size());
+          pools.add(current);
+        }
+      }
+
+      if (current.add(ref))
+      {
+        // It is full
+        current = null;
+      }
+    }
+
+    void remove(JPypeReference ref)
+    {
+      Pool pool = pools.get(ref.pool);
+      pool.remove(ref);
+
+      // The pool just gained a slot so make it available for reuse
+      if (pool != current && !pool.isFree)
+      {
+        pool.isFree = true;
+        pool.nextFree = free;
+        free = pool;
+      }
+    }
+  }
+
   static class Pool
   {
 
     JPypeReference[] entries = new JPypeReference[SIZE];
     int tail;
     int id;
+    boolean isFree;
+    Pool nextFree;
 
     Pool(int id)
     {
@@ -142,6 +232,7 @@ public class JPypeReferenceSet
     {
       entries[ref.index] = entries[--tail];
       entries[ref.index].index = ref.index;
+      entries[tail] = null;
     }
   }
 //</editor-fold>
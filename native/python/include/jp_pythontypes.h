@@ -355,10 +355,18 @@ class JPPyCallRelease
 public:
 	/** Release the lock. */
 	JPPyCallRelease();
+	/** Release the lock only if requested. */
+	explicit JPPyCallRelease(bool release);
+	/** Release the lock if the frame requests it and time the call
+	 * if the frame has a place to record it.
+	 */
+	explicit JPPyCallRelease(JPJavaFrame& frame);
 	/** Reacquire the lock. */
 	~JPPyCallRelease();
 private:
 	void* m_State1;
+	jlong* m_CallTime;
+	jlong m_Start;
 } ;
 
 class JPPyBuffer
@@ -191,6 +191,7 @@ void       PyJPValue_assignJavaSlot(JPJavaFrame &frame, PyObject* obj, const JPV
 bool       PyJPValue_isSetJavaSlot(PyObject* self);
 JPPyObject PyTrace_FromJavaException(JPJavaFrame& frame, jthrowable th, jthrowable prev);
 void       PyJPException_normalize(JPJavaFrame frame, JPPyObject exc, jthrowable th, jthrowable enclosing);
+void       PyJPException_attachCause(JPJavaFrame& frame, PyObject* exc, jthrowable th);
 
 #define _ASSERT_JVM_RUNNING(context) assertJVMRunning((JPContext*)context, JP_STACKINFO())
 
@@ -15,6 +15,7 @@
  *****************************************************************************/
 #include "jpype.h"
 #include "pyjp.h"
+#include <chrono>
 
 /****************************************************************************
  * Base object
@@ -400,17 +401,50 @@ JPPyCallAcquire::~JPPyCallAcquire()
 
 // This is used when leaving python from to perform some
 
+static jlong nanoTime()
+{
+	return (jlong) std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
 JPPyCallRelease::JPPyCallRelease()
 {
 	// Release the lock and set the thread state to NULL
 	m_State1 = (void*) PyEval_SaveThread();
+	m_CallTime = NULL;
+	m_Start = 0;
+}
+
+JPPyCallRelease::JPPyCallRelease(bool release)
+{
+	m_State1 = NULL;
+	m_CallTime = NULL;
+	m_Start = 0;
+	if (release)
+		m_State1 = (void*) PyEval_SaveThread();
+}
+
+JPPyCallRelease::JPPyCallRelease(JPJavaFrame& frame)
+{
+	m_State1 = NULL;
+	m_CallTime = frame.getCallTime();
+	m_Start = 0;
+	if (frame.isReleaseGIL())
+		m_State1 = (void*) PyEval_SaveThread();
+	if (m_CallTime != NULL)
+		m_Start = nanoTime();
 }
 
 JPPyCallRelease::~JPPyCallRelease()
 {
+	// Only the Java call is timed, not the wait for the lock
+	if (m_CallTime != NULL)
+		*m_CallTime = nanoTime() - m_Start;
+
 	// Reaquire the lock
 	PyThreadState *save = (PyThreadState *) m_State1;
-	PyEval_RestoreThread(save);
+	if (save != NULL)
+		PyEval_RestoreThread(save);
 }
 
 JPPyBuffer::JPPyBuffer(PyObject* obj, int flags)
@@ -945,6 +945,28 @@ PyObject* PyJPClass_customize(PyJPClass *self, PyObject *args, PyObject *kwargs)
 	JP_PY_CATCH(NULL);
 }
 
+static PyObject *PyJPClass_setGILPolicy(PyJPClass *self, PyObject *arg)
+{
+	JP_PY_TRY("PyJPClass_setGILPolicy");
+	JPContext *context = PyJPModule_getContext();
+	JPJavaFrame frame = JPJavaFrame::outer(context);
+	long policy = PyLong_AsLong(arg);
+	JP_PY_CHECK();
+	if (policy < JPMethodDispatch::_gil_release || policy > JPMethodDispatch::_gil_adaptive)
+		JP_RAISE(PyExc_ValueError, "invalid GIL policy");
+
+	// Apply to the methods and constructors of this class only
+	JPClass *cls = self->m_Class;
+	cls->ensureMembers(frame);
+	JPMethodDispatchList dispatches = cls->getMethods();
+	if (cls->getCtor() != NULL)
+		dispatches.push_back(cls->getCtor());
+	for (JPMethodDispatchList::iterator iter = dispatches.begin(); iter != dispatches.end(); ++iter)
+		(*iter)->setGILPolicy((int) policy);
+	Py_RETURN_NONE;
+	JP_PY_CATCH(NULL);
+}
+
 static PyMethodDef classMethods[] = {
 	{"__instancecheck__", (PyCFunction) PyJPClass_instancecheck, METH_O, ""},
 	{"__subclasscheck__", (PyCFunction) PyJPClass_subclasscheck, METH_O, ""},
@@ -955,6 +977,7 @@ static PyMethodDef classMethods[] = {
 	{"_canCast", (PyCFunction) PyJPClass_canCast, METH_O, ""},
 	{"__getitem__", (PyCFunction) PyJPClass_array, METH_O | METH_COEXIST, ""},
 	{"_customize", (PyCFunction) PyJPClass_customize, METH_VARARGS, ""},
+	{"_setGILPolicy", (PyCFunction) PyJPClass_setGILPolicy, METH_O, ""},
 	{NULL},
 };
 
@@ -108,6 +108,36 @@ static PyObject *PyJPMethod_call(PyJPMethod *self, PyObject *args, PyObject *kwa
 	JP_PY_CATCH(NULL); // GCOVR_EXCL_LINE
 }
 
+static PyObject *PyJPMethod_map(PyJPMethod *self, PyObject *rows)
+{
+	JP_PY_TRY("PyJPMethod_map");
+	JPContext *context = PyJPModule_getContext();
+	JPJavaFrame frame = JPJavaFrame::outer(context);
+	JP_TRACE(self->m_Method->getName());
+	if (hasInterrupt())
+		frame.clearInterrupt(false);
+	return self->m_Method->invokeMany(frame, self->m_Instance, rows).keep();
+	JP_PY_CATCH(NULL); // GCOVR_EXCL_LINE
+}
+
+static PyObject *PyJPMethod_asyncCall(PyJPMethod *self, PyObject *args)
+{
+	JP_PY_TRY("PyJPMethod_asyncCall");
+	JPContext *context = PyJPModule_getContext();
+	JPJavaFrame frame = JPJavaFrame::outer(context);
+	JP_TRACE(self->m_Method->getName());
+	if (self->m_Instance == NULL)
+	{
+		JPPyObjectVector vargs(args);
+		return self->m_Method->invokeAsync(frame, vargs, false).keep();
+	} else
+	{
+		JPPyObjectVector vargs(self->m_Instance, args);
+		return self->m_Method->invokeAsync(frame, vargs, true).keep();
+	}
+	JP_PY_CATCH(NULL); // GCOVR_EXCL_LINE
+}
+
 static PyObject *PyJPMethod_matches(PyJPMethod *self, PyObject *args, PyObject *kwargs)
 {
 	JP_PY_TRY("PyJPMethod_matches");
@@ -340,12 +370,28 @@ PyObject *PyJPMethod_matchReport(PyJPMethod *self, PyObject *args)
 	JP_PY_CATCH(NULL);
 }
 
+static PyObject *PyJPMethod_setGILPolicy(PyJPMethod *self, PyObject *arg)
+{
+	JP_PY_TRY("PyJPMethod_setGILPolicy");
+	PyJPModule_getContext();
+	long policy = PyLong_AsLong(arg);
+	JP_PY_CHECK();
+	if (policy < JPMethodDispatch::_gil_release || policy > JPMethodDispatch::_gil_adaptive)
+		JP_RAISE(PyExc_ValueError, "invalid GIL policy");
+	self->m_Method->setGILPolicy((int) policy);
+	Py_RETURN_NONE;
+	JP_PY_CATCH(NULL);
+}
+
 static PyMethodDef methodMethods[] = {
 	{"_isBeanAccessor", (PyCFunction) (&PyJPMethod_isBeanAccessor), METH_NOARGS, ""},
 	{"_isBeanMutator", (PyCFunction) (&PyJPMethod_isBeanMutator), METH_NOARGS, ""},
 	{"matchReport", (PyCFunction) (&PyJPMethod_matchReport), METH_VARARGS, ""},
+	{"map", (PyCFunction) (&PyJPMethod_map), METH_O, ""},
+	{"_asyncCall", (PyCFunction) (&PyJPMethod_asyncCall), METH_VARARGS, ""},
 	// This is  currently private but may be promoted
 	{"_matches", (PyCFunction) (&PyJPMethod_matches), METH_VARARGS, ""},
+	{"_setGILPolicy", (PyCFunction) (&PyJPMethod_setGILPolicy), METH_O, ""},
 	{NULL},
 };
 
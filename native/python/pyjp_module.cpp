@@ -319,6 +319,27 @@ static PyObject* PyJPModule_detachThread(PyObject* obj)
 }
 #endif
 
+static PyObject* PyJPModule_setAutoDetach(PyObject* obj, PyObject* arg)
+{
+	JP_PY_TRY("PyJPModule_setAutoDetach");
+	int enable = PyObject_IsTrue(arg);
+	JP_PY_CHECK();
+	JPContext_global->setAutoDetach(enable != 0);
+	Py_RETURN_NONE;
+	JP_PY_CATCH(NULL);
+}
+
+static PyObject* PyJPModule_getThreadStats(PyObject* obj)
+{
+	JP_PY_TRY("PyJPModule_getThreadStats");
+	jlong attached, detached, autoDetached;
+	JPContext_global->getThreadStats(attached, detached, autoDetached);
+	return Py_BuildValue("{sLsLsL}", "attached", (long long) attached,
+			"detached", (long long) detached,
+			"autoDetached", (long long) autoDetached);
+	JP_PY_CATCH(NULL);
+}
+
 static PyObject* PyJPModule_isThreadAttached(PyObject* obj)
 {
 	JP_PY_TRY("PyJPModule_isThreadAttached");
@@ -671,6 +692,8 @@ static PyMethodDef moduleMethods[] = {
 	{"detachThreadFromJVM", (PyCFunction) PyJPModule_detachThread, METH_NOARGS, ""},
 	{"attachThreadAsDaemon", (PyCFunction) PyJPModule_attachThreadAsDaemon, METH_NOARGS, ""},
 #endif
+	{"_setAutoDetach", (PyCFunction) PyJPModule_setAutoDetach, METH_O, ""},
+	{"_getThreadStats", (PyCFunction) PyJPModule_getThreadStats, METH_NOARGS, ""},
 
 	//{"dumpJVMStats", (PyCFunction) (&PyJPModule_dumpJVMStats), METH_NOARGS, ""},
 
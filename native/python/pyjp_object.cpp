@@ -17,6 +17,9 @@
 #include "pyjp.h"
 #include <structmember.h>
 
+// Longest chain of Java causes converted for an exception
+static const int MAX_CAUSE_DEPTH = 16;
+
 #ifdef __cplusplus
 extern "C"
 {
@@ -279,6 +282,49 @@ static int PyJPException_init(PyObject *self, PyObject *pyargs, PyObject *kwargs
 	JP_PY_CATCH(-1);  // GCOVR_EXCL_LINE
 }
 
+/**
+ * Fill in the arguments of an exception created from Java.
+ *
+ * Exceptions from Java hold a placeholder until the message is used as
+ * fetching it is wasted if the exception is caught and discarded.
+ */
+static void PyJPException_expandArgs(PyObject *self)
+{
+	PyBaseExceptionObject *exc = (PyBaseExceptionObject*) self;
+	if (exc->args == NULL || PyTuple_Size(exc->args) != 1
+			|| PyTuple_GetItem(exc->args, 0) != _JObjectKey)
+		return;
+	JPContext *context = PyJPModule_getContext();
+	JPJavaFrame frame = JPJavaFrame::outer(context);
+	JPValue *val = PyJPValue_getJavaSlot(self);
+	JPPyObject args;
+	if (val == NULL || val->getValue().l == NULL)
+	{
+		args = JPPyObject::call(PyTuple_New(0));
+	} else
+	{
+		jobject th = val->getValue().l;
+		jstring m = frame.getMessage((jthrowable) th);
+		if (m != NULL)
+			args = JPPyObject::call(PyTuple_Pack(1,
+				JPPyString::fromStringUTF8(frame.toStringUTF8(m)).get()));
+		else
+			args = JPPyObject::call(PyTuple_Pack(1,
+				JPPyString::fromStringUTF8(frame.toString(th)).get()));
+	}
+	PyObject *old = exc->args;
+	exc->args = args.keep();
+	Py_DECREF(old);
+}
+
+static PyObject *PyJPException_repr(PyObject *self)
+{
+	JP_PY_TRY("PyJPException_repr");
+	PyJPException_expandArgs(self);
+	return ((PyTypeObject*) PyExc_BaseException)->tp_repr(self);
+	JP_PY_CATCH(NULL);  // GCOVR_EXCL_LINE
+}
+
 static PyObject* PyJPException_expandStacktrace(PyObject* self)
 {
 	JP_PY_TRY("PyJPModule_expandStackTrace");
@@ -297,14 +343,29 @@ static PyObject* PyJPException_expandStacktrace(PyObject* self)
 
 PyObject *PyJPException_args(PyBaseExceptionObject *self)
 {
+	JP_PY_TRY("PyJPException_args");
+	PyJPException_expandArgs((PyObject*) self);
 	if (self->args == NULL)
 		Py_RETURN_NONE;  // GCOVR_EXCL_LINE
 	Py_INCREF(self->args);
 	return self->args;
+	JP_PY_CATCH(NULL);  // GCOVR_EXCL_LINE
+}
+
+static PyObject *PyJPException_reduce(PyObject *self, PyObject *arg)
+{
+	JP_PY_TRY("PyJPException_reduce");
+	// BaseException.__reduce__ reads the arguments directly, so they must
+	// hold the message rather than the placeholder.
+	PyJPException_expandArgs(self);
+	JPPyObject reduce = JPPyObject::call(PyObject_GetAttrString(PyExc_BaseException, "__reduce__"));
+	return PyObject_CallFunctionObjArgs(reduce.get(), self, NULL);
+	JP_PY_CATCH(NULL);  // GCOVR_EXCL_LINE
 }
 
 static PyMethodDef exceptionMethods[] = {
 	{"_expandStacktrace", (PyCFunction) PyJPException_expandStacktrace, METH_NOARGS, ""},
+	{"__reduce__", (PyCFunction) PyJPException_reduce, METH_NOARGS, ""},
 	{NULL},
 };
 
@@ -318,6 +379,7 @@ static PyType_Slot excSlots[] = {
 	{Py_tp_new,      (void*) &PyJPException_new},
 	{Py_tp_init,     (void*) &PyJPException_init},
 	{Py_tp_str,      (void*) &PyJPValue_str},
+	{Py_tp_repr,     (void*) &PyJPException_repr},
 	{Py_tp_getattro, (void*) &PyJPValue_getattro},
 	{Py_tp_setattro, (void*) &PyJPValue_setattro},
 	{Py_tp_methods,  exceptionMethods},
@@ -372,27 +434,77 @@ void PyJPObject_initType(PyObject* module)
 	JP_PY_CHECK(); // GCOVR_EXCL_LINE
 }
 
+/**
+ * Convert a Java cause to Python.
+ *
+ * Causes are usually of the same few classes so the class is taken from the
+ * exception cache rather than looked up in Java.
+ */
+static JPPyObject PyJPException_convertCause(JPJavaFrame& frame, jthrowable th)
+{
+	JPClass *cls = frame.getContext()->getTypeManager()->findClassForThrowable(frame, th);
+	jvalue v;
+	v.l = (jobject) th;
+	return cls->convertToPythonObject(frame, v, true);
+}
+
+/**
+ * Add the Java stack frames and causes of a throwable as the cause of an
+ * exception.
+ */
+void PyJPException_attachCause(JPJavaFrame& frame, PyObject* exc, jthrowable th)
+{
+	JP_TRACE_IN("PyJPException_attachCause");
+	JPPyObject args = JPPyObject::call(Py_BuildValue("(s)", "Java Exception"));
+	JPPyObject cause = JPPyObject::call(PyObject_Call(PyExc_Exception, args.get(), NULL));
+	JPPyObject trace = PyTrace_FromJavaException(frame, th, NULL);
+
+	// Attach Java causes as well.
+	try
+	{
+		jthrowable jcause = frame.getCause(th);
+		if (jcause != NULL)
+		{
+			JPPyObject prev = PyJPException_convertCause(frame, jcause);
+			PyJPException_normalize(frame, prev, jcause, th);
+			PyException_SetCause(cause.get(), prev.keep());
+		}
+		if (!trace.isNull())
+			PyException_SetTraceback(cause.get(), trace.get());
+		PyException_SetCause(exc, cause.keep());
+	}	catch (JPypeException& ex)
+	{
+		JP_TRACE("FAILURE IN CAUSE");
+		// Any failures in this optional action should be ignored.
+		// worst case we don't print as much diagnostics.
+		PyErr_Clear();
+		PyException_SetCause(exc, NULL);
+	}
+	JP_TRACE_OUT; // GCOVR_EXCL_LINE
+}
+
 /**
  * Attach stack frames and causes as required for a Python exception.
  */
 void PyJPException_normalize(JPJavaFrame frame, JPPyObject exc, jthrowable th, jthrowable enclosing)
 {
 	JP_TRACE_IN("PyJPException_normalize");
-	JPContext *context = frame.getContext();
-	while (th != NULL)
+	// Causes beyond the limit are dropped rather than converted as long
+	// chains are usually the same failure rethrown at each layer.
+	for (int depth = 1; th != NULL; ++depth)
 	{
 		// Attach the frame to first
 		JPPyObject trace = PyTrace_FromJavaException(frame, th, enclosing);
 		PyException_SetTraceback(exc.get(), trace.get());
 
 		// Check for the next in the cause list
+		if (depth == MAX_CAUSE_DEPTH)
+			return;
 		enclosing = th;
 		th = frame.getCause(th);
 		if (th == NULL)
 			return;
-		jvalue v;
-		v.l = (jobject) th;
-		JPPyObject next = context->_java_lang_Object->convertToPythonObject(frame, v, false);
+		JPPyObject next = PyJPException_convertCause(frame, th);
 
 		// This may already be a Python exception
 		JPValue *val = PyJPValue_getJavaSlot(next.get());
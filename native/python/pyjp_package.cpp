@@ -16,6 +16,7 @@
 #include "jpype.h"
 #include "pyjp.h"
 #include "jp_stringtype.h"
+#include "jp_classloader.h"
 #include <structmember.h>
 
 #ifdef __cplusplus
@@ -24,6 +25,9 @@ extern "C"
 #endif
 PyTypeObject *PyJPPackage_Type = NULL;
 static PyObject *PyJPPackage_Dict = NULL;
+// Names not found in each package, keyed by the package name.
+static PyObject *PyJPPackage_Missing = NULL;
+static jint PyJPPackage_MissingGeneration = 0;
 
 static PyObject *PyJPPackage_new(PyTypeObject *type, PyObject *args, PyObject *kwargs)
 {
@@ -98,6 +102,51 @@ static jobject getPackage(JPJavaFrame &frame, PyObject *self)
 	return NULL;
 }
 
+/**
+ * Check if a name was not found in the package before.
+ *
+ * Names which are not found are remembered until the class path changes
+ * so that repeated probes do not go to Java.  The names are kept in a
+ * table outside of the package so that they do not appear as attributes.
+ *
+ * @param self is the package.
+ * @param attr is the name of the attribute.
+ * @param generation is the current generation of the class path.
+ * @return true if the name is known to be missing.
+ */
+static bool isMissing(PyObject *self, PyObject *attr, jint generation)
+{
+	if (generation != PyJPPackage_MissingGeneration)
+	{
+		// The class path changed so start over.
+		PyDict_Clear(PyJPPackage_Missing);
+		PyJPPackage_MissingGeneration = generation;
+		return false;
+	}
+	PyObject *name = PyModule_GetNameObject(self);
+	if (name == NULL)
+	{
+		PyErr_Clear();
+		return false;
+	}
+	PyObject *missing = PyDict_GetItem(PyJPPackage_Missing, name); // borrowed
+	Py_DECREF(name);
+	return missing != NULL && PySet_Contains(missing, attr) == 1;
+}
+
+static void addMissing(PyObject *self, PyObject *attr)
+{
+	JPPyObject name = JPPyObject::call(PyModule_GetNameObject(self));
+	PyObject *missing = PyDict_GetItem(PyJPPackage_Missing, name.get()); // borrowed
+	if (missing == NULL)
+	{
+		JPPyObject set = JPPyObject::call(PySet_New(NULL));
+		PyDict_SetItem(PyJPPackage_Missing, name.get(), set.get()); // no steal
+		missing = set.get();
+	}
+	PySet_Add(missing, attr);
+}
+
 /**
  * Get an attribute from the package.
  *
@@ -144,6 +193,13 @@ static PyObject *PyJPPackage_getattro(PyObject *self, PyObject *attr)
 		return 0;
 	}
 	JPJavaFrame frame = JPJavaFrame::outer(context);
+	jint generation = context->getClassLoader()->getGeneration(frame);
+	if (isMissing(self, attr, generation))
+	{
+		PyErr_Format(PyExc_AttributeError, "Java package '%s' has no attribute '%U'",
+				PyModule_GetName(self), attr);
+		return NULL;
+	}
 	jobject pkg = getPackage(frame, self);
 	if (pkg == NULL)
 		return NULL;
@@ -173,6 +229,9 @@ static PyObject *PyJPPackage_getattro(PyObject *self, PyObject *attr)
 	}
 	if (obj == NULL)
 	{
+		// Classes may be added to a directory at any time.
+		if (!frame.isPackageDirectory(pkg))
+			addMissing(self, attr);
 		PyErr_Format(PyExc_AttributeError, "Java package '%s' has no attribute '%U'",
 				PyModule_GetName(self), attr);
 		return NULL;
@@ -348,4 +407,8 @@ void PyJPPackage_initType(PyObject* module)
 	// Set up a dictionary so we can reuse packages
 	PyJPPackage_Dict = PyDict_New();
 	PyModule_AddObject(module, "_packages", PyJPPackage_Dict);
+
+	// Set up a dictionary for the names not found
+	PyJPPackage_Missing = PyDict_New();
+	JP_PY_CHECK();
 }
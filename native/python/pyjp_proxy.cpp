@@ -37,8 +37,14 @@ static PyObject *PyJPProxy_new(PyTypeObject *type, PyObject *args, PyObject *kwa
 	PyObject *target;
 	PyObject *pyintf;
 	int convert = 0;
-	if (!PyArg_ParseTuple(args, "OO|p", &target, &pyintf, &convert))
+	int asynchronous = 0;
+	JPProxyOptions options;
+	if (!PyArg_ParseTuple(args, "OO|ppiL", &target, &pyintf, &convert,
+			&asynchronous, &options.m_BatchSize, &options.m_BatchLatency))
 		return NULL;
+	options.m_Asynchronous = (asynchronous != 0);
+	if (options.m_BatchSize < 0 || options.m_BatchLatency < 0)
+		JP_RAISE(PyExc_ValueError, "batch size and latency must not be negative");
 
 	// Pack interfaces
 	if (!PySequence_Check(pyintf))
@@ -65,9 +71,9 @@ static PyObject *PyJPProxy_new(PyTypeObject *type, PyObject *args, PyObject *kwa
 	}
 
 	if (target == Py_None)
-		self->m_Proxy = new JPProxyDirect(context, self, interfaces);
+		self->m_Proxy = new JPProxyDirect(context, self, interfaces, options);
 	else
-		self->m_Proxy = new JPProxyIndirect(context, self, interfaces);
+		self->m_Proxy = new JPProxyIndirect(context, self, interfaces, options);
 	self->m_Target = target;
 	self->m_Convert = (convert != 0);
 	Py_INCREF(target);
@@ -81,21 +87,26 @@ static PyObject *PyJPProxy_new(PyTypeObject *type, PyObject *args, PyObject *kwa
 static int PyJPProxy_traverse(PyJPProxy *self, visitproc visit, void *arg)
 {
 	Py_VISIT(self->m_Target);
+	if (self->m_Proxy != NULL)
+		return self->m_Proxy->traverseCallables(visit, arg);
 	return 0;
 }
 
 static int PyJPProxy_clear(PyJPProxy *self)
 {
 	Py_CLEAR(self->m_Target);
+	if (self->m_Proxy != NULL)
+		self->m_Proxy->clearCallables();
 	return 0;
 }
 
 void PyJPProxy_dealloc(PyJPProxy* self)
 {
 	JP_PY_TRY("PyJPProxy_dealloc");
-	delete self->m_Proxy;
 	PyObject_GC_UnTrack(self);
 	PyJPProxy_clear(self);
+	delete self->m_Proxy;
+	self->m_Proxy = NULL;
 	Py_TYPE(self)->tp_free(self);
 	JP_PY_CATCH_NONE();
 }
@@ -15,6 +15,8 @@
 **************************************************************************** */
 package jpype.lambda;
 
+import java.util.AbstractList;
+import java.util.List;
 import java.util.function.Function;
 
 public class Test1
@@ -35,4 +37,20 @@ public class Test1
   {
     return (Double d) -> (d + 1);
   }
+
+  public List<Integer> getAnonymous()
+  {
+    return new AbstractList<Integer>()
+    {
+      public Integer get(int i)
+      {
+        return i;
+      }
+
+      public int size()
+      {
+        return 3;
+      }
+    };
+  }
 }
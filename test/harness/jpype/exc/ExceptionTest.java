@@ -64,4 +64,21 @@ public class ExceptionTest
   {
     throw new RuntimeException("Inner");
   }
+
+  public static void throwAnonymous()
+  {
+    throw new RuntimeException("anonymous")
+    {
+    };
+  }
+
+  public static void throwDeepChain(int depth)
+  {
+    RuntimeException ex = new RuntimeException("0");
+    for (int i = 1; i < depth; ++i)
+    {
+      ex = new RuntimeException(Integer.toString(i), ex);
+    }
+    throw ex;
+  }
 }
@@ -0,0 +1,63 @@
+/* ****************************************************************************
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  See NOTICE file for details.
+**************************************************************************** */
+package jpype.proxy;
+
+import java.util.concurrent.atomic.AtomicInteger;
+
+public class AsyncProducer
+{
+
+  /**
+   * Call a proxy from several threads at once.
+   *
+   * Thread t sends the values t*count to t*count+count-1 in order.
+   *
+   * @return the number of calls which failed.
+   */
+  public static int produce(final TestAsync proxy, int threads, final int count)
+          throws InterruptedException
+  {
+    final AtomicInteger failures = new AtomicInteger();
+    Thread[] workers = new Thread[threads];
+    for (int t = 0; t < threads; ++t)
+    {
+      final int base = t * count;
+      workers[t] = new Thread()
+      {
+        @Override
+        public void run()
+        {
+          for (int i = 0; i < count; ++i)
+          {
+            try
+            {
+              proxy.notifyValue(base + i);
+            } catch (Throwable th)
+            {
+              failures.incrementAndGet();
+            }
+          }
+        }
+      };
+      workers[t].start();
+    }
+    for (Thread worker : workers)
+    {
+      worker.join();
+    }
+    return failures.get();
+  }
+}
@@ -0,0 +1,94 @@
+# *****************************************************************************
+#
+#   Licensed under the Apache License, Version 2.0 (the "License");
+#   you may not use this file except in compliance with the License.
+#   You may obtain a copy of the License at
+#
+#       http://www.apache.org/licenses/LICENSE-2.0
+#
+#   Unless required by applicable law or agreed to in writing, software
+#   distributed under the License is distributed on an "AS IS" BASIS,
+#   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#   See the License for the specific language governing permissions and
+#   limitations under the License.
+#
+#   See NOTICE file for details.
+#
+# *****************************************************************************
+import asyncio
+import jpype
+from jpype.types import *
+import common
+
+
+class AsyncioTestCase(common.JPypeTestCase):
+
+    def setUp(self):
+        common.JPypeTestCase.setUp(self)
+        self.loop = asyncio.new_event_loop()
+        asyncio.set_event_loop(self.loop)
+
+    def tearDown(self):
+        asyncio.set_event_loop(None)
+        self.loop.close()
+
+    def testAsyncCallStatic(self):
+        Math = JClass("java.lang.Math")
+
+        async def call():
+            return await Math.abs.asyncCall(-5)
+        self.assertEqual(self.loop.run_until_complete(call()), 5)
+
+    def testAsyncCallBound(self):
+        s = JString("hello world")
+
+        async def call():
+            return await s.substring.asyncCall(6)
+        self.assertEqual(self.loop.run_until_complete(call()), "world")
+
+    def testAsyncCallRaises(self):
+        s = JString("hello")
+
+        async def call():
+            return await s.substring.asyncCall(10)
+        with self.assertRaises(JClass("java.lang.StringIndexOutOfBoundsException")):
+            self.loop.run_until_complete(call())
+
+    def testAwaitCompleted(self):
+        CompletableFuture = JClass("java.util.concurrent.CompletableFuture")
+
+        async def call():
+            return await CompletableFuture.completedFuture(JInt(5))
+        self.assertEqual(self.loop.run_until_complete(call()), 5)
+
+    def testAwaitPending(self):
+        CompletableFuture = JClass("java.util.concurrent.CompletableFuture")
+        cf = CompletableFuture()
+
+        async def call():
+            self.loop.call_later(0.05, cf.complete, "done")
+            return await cf
+        self.assertEqual(self.loop.run_until_complete(call()), "done")
+
+    def testAwaitFailed(self):
+        CompletableFuture = JClass("java.util.concurrent.CompletableFuture")
+        cf = CompletableFuture()
+        cf.completeExceptionally(JClass("java.lang.IllegalStateException")("bad"))
+
+        async def call():
+            return await cf
+        with self.assertRaises(JClass("java.lang.IllegalStateException")):
+            self.loop.run_until_complete(call())
+
+    def testAsyncCallJavaThread(self):
+        Thread = JClass("java.lang.Thread")
+
+        async def call():
+            return await Thread.currentThread.asyncCall()
+        thread = self.loop.run_until_complete(call())
+        self.assertNotEqual(thread, Thread.currentThread())
+        self.assertTrue(thread.isDaemon())
+
+    def testAsyncCallNoLoop(self):
+        with self.assertRaises(RuntimeError):
+            JClass("java.lang.Math").abs.asyncCall(-5)
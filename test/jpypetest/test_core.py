@@ -16,6 +16,8 @@
 #
 # *****************************************************************************
 from unittest import mock
+import os
+import tempfile
 import jpype
 import common
 from jpype.types import *
@@ -33,6 +35,17 @@ class JCharTestCase(common.JPypeTestCase):
         mock_sys.version_info = (3, 8)
         jpype._core.versionTest()
 
+    def testJavaVersion(self):
+        with tempfile.TemporaryDirectory() as home:
+            lib = os.path.join(home, "lib", "server")
+            os.makedirs(lib)
+            jvm = os.path.join(lib, "libjvm.so")
+            self.assertIsNone(jpype._core._javaVersion(jvm))
+            for version, major in (('1.8.0_292', 8), ('11.0.2', 11), ('17', 17), ('21-ea', 21)):
+                with open(os.path.join(home, "release"), "w") as fd:
+                    fd.write('IMPLEMENTOR="Test"\nJAVA_VERSION="%s"\n' % version)
+                self.assertEqual(jpype._core._javaVersion(jvm), major)
+
     def testShutdownHook(self):
         Thread = JClass("java.lang.Thread")
         Runnable = JClass("java.lang.Runnable")
@@ -65,3 +78,29 @@ class JCharTestCase(common.JPypeTestCase):
         th.start()
         th.join()
         self.assertTrue(run.rc)
+
+    def testPreload(self):
+        task = jpype.preload(["java.util.zip.*", "java.util.BitSet"], threads=2)
+        self.assertTrue(task.waitFor(0))
+        self.assertTrue(task.isDone())
+        self.assertGreater(task.getTotal(), 1)
+        self.assertGreater(task.getLoaded(), 1)
+        self.assertEqual(task.getLoaded() + task.getFailed(), task.getTotal())
+        self.assertIn("Preloaded", str(task))
+        # Preloaded classes are ready to use
+        self.assertEqual(JClass("java.util.zip.CRC32")().getValue(), 0)
+
+    def testPreloadWrapper(self):
+        Checksum = JClass("java.util.zip.Checksum")
+        task = jpype.preload("java.util.zip.Adler32")
+        task.waitFor(0)
+        self.assertEqual(task.getLoaded(), 1)
+        # The Python wrapper is created by the preload, not on first use
+        names = [i.__name__ for i in Checksum.__subclasses__()]
+        self.assertIn("java.util.zip.Adler32", names)
+
+    def testPreloadMissing(self):
+        task = jpype.preload("java.util.NoSuchClass")
+        task.waitFor(0)
+        self.assertEqual(task.getTotal(), 1)
+        self.assertEqual(task.getFailed(), 1)
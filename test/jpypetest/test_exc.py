@@ -111,6 +111,88 @@ class ExceptionTestCase(common.JPypeTestCase):
             frame = frame.tb_next
             i += 1
 
+    def testLazyMessage(self):
+        try:
+            java.lang.Integer.parseInt("x")
+        except JException as ex:
+            ex1 = ex
+        self.assertEqual(ex1.args, ('For input string: "x"',))
+        self.assertIn('For input string', repr(ex1))
+
+    def testLazyMessageReduce(self):
+        import copy
+        try:
+            java.lang.Integer.parseInt("x")
+        except JException as ex:
+            ex1 = ex
+        # The placeholder must not leak through BaseException.__reduce__
+        self.assertEqual(ex1.__reduce__()[1], ('For input string: "x"',))
+        ex2 = copy.copy(ex1)
+        self.assertIsInstance(ex2, java.lang.NumberFormatException)
+        self.assertEqual(str(ex2.getMessage()), 'For input string: "x"')
+
+    def testCauseAttached(self):
+        cls = jpype.JClass("jpype.exc.ExceptionTest")
+        causes = []
+        for i in range(2):
+            try:
+                cls.throwChain()
+            except Exception as ex:
+                ex1 = ex
+            causes.append(ex1.__cause__)
+            text = "".join(traceback.format_exception(type(ex1), ex1, ex1.__traceback__))
+            self.assertIn("jpype.exc.ExceptionTest.method2", text)
+            self.assertIn("Java Exception", text)
+        # Each exception has its own cause holding its Java frames
+        self.assertIsNot(causes[0], causes[1])
+        self.assertIsNotNone(causes[0].__traceback__)
+
+    def testClassCached(self):
+        types = []
+        for i in range(3):
+            try:
+                java.lang.Integer.parseInt("x")
+            except JException as ex:
+                types.append(type(ex))
+        self.assertIs(types[0], java.lang.NumberFormatException)
+        self.assertIs(types[1], types[0])
+        self.assertIs(types[2], types[0])
+        # Mapped exceptions keep their Python base when cached
+        for i in range(2):
+            with self.assertRaises(IndexError):
+                java.util.ArrayList().get(0)
+
+    def testClassCachedAnonymous(self):
+        cls = jpype.JClass("jpype.exc.ExceptionTest")
+        for i in range(2):
+            try:
+                cls.throwAnonymous()
+            except java.lang.RuntimeException as ex:
+                self.assertIsNot(type(ex), java.lang.RuntimeException)
+        try:
+            cls.throwRuntime()
+        except JException as ex:
+            # The base class must not match the anonymous wrapper
+            self.assertIs(type(ex), java.lang.RuntimeException)
+
+    def testDeepCause(self):
+        cls = jpype.JClass("jpype.exc.ExceptionTest")
+        try:
+            cls.throwDeepChain(100)
+        except Exception as ex:
+            ex1 = ex
+        self.assertEqual(str(ex1.getMessage()), "99")
+        depth = 0
+        cause = ex1.__cause__.__cause__
+        while cause is not None:
+            self.assertIsInstance(cause, java.lang.RuntimeException)
+            depth += 1
+            last = cause
+            cause = cause.__cause__
+        # Conversion stops after MAX_CAUSE_DEPTH (16) causes
+        self.assertEqual(depth, 16)
+        self.assertEqual(str(last.getMessage()), "83")
+
     def testIndexError(self):
         with self.assertRaises(IndexError):
             raise java.lang.IndexOutOfBoundsException("From Java")
@@ -136,6 +136,18 @@ class ImportsTestCase(common.JPypeTestCase):
         import org
         self.assertTrue("missing" in dir(org.jpype))
 
+    def testScanJars(self):
+        import pathlib
+        Paths = jpype.JClass('java.nio.file.Paths')
+        ClassLoader = jpype.JClass('java.lang.ClassLoader')
+        DynamicClassLoader = jpype.JClass('org.jpype.classloader.DynamicClassLoader')
+        cl = DynamicClassLoader(ClassLoader.getSystemClassLoader())
+        jars = ["test/jar/mrjar.jar", "test/jar/missing.jar", "test/jar/late/late.jar"]
+        cl.addFiles([Paths.get(str(pathlib.Path(i).absolute())) for i in jars])
+        # Directories missing from the jar are recreated
+        self.assertIsNotNone(cl.getResource("org/jpype/missing"))
+        self.assertIsNotNone(cl.getResource("org/jpype/late/Test.class"))
+
 
 @subrun.TestCase
 class ImportsBeforeCase(common.unittest.TestCase):
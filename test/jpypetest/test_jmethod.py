@@ -315,3 +315,97 @@ class JMethodTestCase(common.JPypeTestCase):
         self.assertTrue(js.substring._matches(1))
         self.assertTrue(js.substring._matches(1, 2))
         self.assertFalse(js.substring._matches(1, 2, 3))
+
+    def testGILPolicy(self):
+        Fixture = JClass("jpype.common.Fixture")
+        fixture = Fixture()
+        try:
+            jpype.setGILPolicy(Fixture.callInt, "never")
+            self.assertEqual(fixture.callInt(1), 1)
+            jpype.setGILPolicy(Fixture.callInt, "adaptive")
+            for i in range(100):
+                self.assertEqual(fixture.callInt(i), i)
+            jpype.setGILPolicy(Fixture, "never")
+            self.assertEqual(Fixture().callInt(2), 2)
+            self.assertEqual(Fixture.callStaticInt(3), 3)
+        finally:
+            jpype.setGILPolicy(Fixture, "always")
+        self.assertEqual(fixture.callInt(4), 4)
+
+    def testGILPolicyInherited(self):
+        import threading
+        import time
+        Thread = JClass("java.lang.Thread")
+        Worker = JClass("java.util.concurrent.ForkJoinWorkerThread")
+        seen = []
+        stop = threading.Event()
+
+        def spin():
+            while not stop.is_set():
+                seen.append(time.monotonic())
+                time.sleep(0.005)
+        spinner = threading.Thread(target=spin)
+        try:
+            # The policy of a subclass must not change the base class
+            jpype.setGILPolicy(Worker, "never")
+            spinner.start()
+            start = time.monotonic()
+            Thread.sleep(300)
+            end = time.monotonic()
+            # Python ran while the base class method was in Java
+            during = [t for t in seen if start + 0.1 < t < end - 0.1]
+            self.assertTrue(during)
+        finally:
+            stop.set()
+            spinner.join()
+            jpype.setGILPolicy(Worker, "always")
+
+    def testLazyOverloads(self):
+        # BufferedWriter.write includes overloads declared by Writer
+        StringWriter = JClass("java.io.StringWriter")
+        sw = StringWriter()
+        bw = JClass("java.io.BufferedWriter")(sw)
+        self.assertIn("write", dir(bw))
+        bw.write("abc")
+        bw.write("defg", 1, 2)
+        bw.flush()
+        self.assertEqual(sw.toString(), "abcef")
+        self.assertIn("has 5 overloads", bw.write.matchReport())
+
+    def testMap(self):
+        Fixture = JClass("jpype.common.Fixture")
+        fixture = Fixture()
+        self.assertEqual(fixture.callInt.map((i,) for i in range(1000)),
+                         list(range(1000)))
+        self.assertEqual(Fixture.callStaticInt.map([(1,), (2,)]), [1, 2])
+        self.assertEqual(Fixture.callInt.map([(fixture, 3)]), [3])
+        self.assertEqual(fixture.callInt.map([]), [])
+        js = JClass("java.lang.String")("hello")
+        self.assertEqual(js.substring.map([(1,), (1, 3)]), ["ello", "el"])
+        self.assertEqual(js.length.map([(), ()]), [5, 5])
+
+    def testMapUnboundTemporary(self):
+        # Each row holds the only reference to its object
+        JString = JClass("java.lang.String")
+        rows = ((JString("x" * (i % 7)),) for i in range(600))
+        self.assertEqual(JString.length.map(rows), [i % 7 for i in range(600)])
+
+    def testMapVoid(self):
+        obj = JClass("java.util.ArrayList")()
+        self.assertEqual(obj.clear.map([(), ()]), None)
+
+    def testMapBad(self):
+        fixture = JClass("jpype.common.Fixture")()
+        with self.assertRaises(TypeError):
+            fixture.callInt.map([1, 2])
+        with self.assertRaises(TypeError):
+            fixture.callInt.map([(1,), ("a",)])
+        with self.assertRaises(TypeError):
+            fixture.callInt.map(None)
+
+    def testGILPolicyBad(self):
+        Fixture = JClass("jpype.common.Fixture")
+        with self.assertRaises(ValueError):
+            jpype.setGILPolicy(Fixture.callInt, "sometimes")
+        with self.assertRaises(TypeError):
+            jpype.setGILPolicy(object(), "never")
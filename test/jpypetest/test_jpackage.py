@@ -74,3 +74,31 @@ class JPackageTestCase(common.JPypeTestCase):
         JL = JPackage("java.lng")
         with self.assertRaisesRegex(AttributeError, "Java package 'java.lng' is not valid"):
             getattr(JL, "foo")
+
+    def testMissingCached(self):
+        JL = JPackage("java.lang")
+        for i in range(2):
+            with self.assertRaisesRegex(AttributeError, "has no attribute 'NoSuchClass'"):
+                getattr(JL, "NoSuchClass")
+        # The names not found must not show as attributes
+        self.assertNotIn("NoSuchClass", JL.__dict__)
+        self.assertEqual([i for i in JL.__dict__ if "missing" in i], [])
+
+    def testMissingInvalidated(self):
+        # Changing the class path advances the generation which makes
+        # JPackage forget the names not found.  Use a private loader so the
+        # shared class path is not changed.
+        ClassLoader = JClass('java.lang.ClassLoader')
+        DynamicClassLoader = JClass('org.jpype.classloader.DynamicClassLoader')
+        cl = DynamicClassLoader(ClassLoader.getSystemClassLoader())
+        generation = cl.getGeneration()
+        cl.addFiles([])
+        self.assertNotEqual(cl.getGeneration(), generation)
+
+    def testMissingDirectory(self):
+        # The test classes are in a directory so misses are probed each time
+        JC = JPackage("jpype.common")
+        for i in range(2):
+            with self.assertRaises(AttributeError):
+                getattr(JC, "NoSuchClass")
+        self.assertIsInstance(JC.Fixture, JClass)
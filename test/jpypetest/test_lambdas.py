@@ -50,3 +50,24 @@ class LambdasTestCase(common.JPypeTestCase):
         func = self.lambdas.getFunction()
         func2 = self.lambdas.getFunction()
         self.assertNotEqual(func, func2)
+
+    def testLambdasType(self):
+        Function = jpype.JClass("java.util.function.Function")
+        self.assertIs(type(self.lambdas.getLambda()), Function)
+        self.assertIs(type(self.lambdas.getFunction()), Function)
+
+    def testAnonymousExtends(self):
+        a = self.lambdas.getAnonymous()
+        self.assertIsInstance(a, jpype.JClass("java.util.AbstractList"))
+        self.assertEqual(list(a), [0, 1, 2])
+        self.assertIs(type(a), type(self.lambdas.getAnonymous()))
+
+    def testAnonymousMemoised(self):
+        manager = jpype.JClass("org.jpype.JPypeContext").getInstance().getTypeManager()
+        self.lambdas.getAnonymous()
+        self.lambdas.getLambda()
+        count = manager.classMap.size()
+        for i in range(10):
+            self.lambdas.getAnonymous()
+            self.lambdas.getLambda()
+        self.assertEqual(manager.classMap.size(), count)
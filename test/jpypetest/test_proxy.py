@@ -16,7 +16,9 @@
 #
 # *****************************************************************************
 import contextlib
+import os
 import sys
+import threading
 
 from jpype import *
 import common
@@ -294,6 +296,16 @@ class ProxyTestCase(common.JPypeTestCase):
         self.assertEqual(start, 12)
         self.assertEqual(length, 13)
 
+    def testProxyRepeatedCalls(self):
+        # Callables are cached per method so repeated calls must
+        # keep dispatching to the correct method.
+        itf1 = self.package.TestInterface1
+        itf2 = self.package.TestInterface2
+        proxy = JProxy([itf1, itf2], inst=C())
+        expected = ['Test Method1 = 43', 'Test Method2 = 42']
+        for i in range(10):
+            self.assertSequenceEqual(self._triggers.testProxy(proxy), expected)
+
     def testProxyJObjectCast(self):
         jrun = JClass('java.lang.Runnable')
         jobj = JClass("java.lang.Object")
@@ -497,6 +509,155 @@ class ProxyTestCase(common.JPypeTestCase):
         self.assertEqual(js.applyAsDouble(1), 2.0)
 
 
+    def testFunctionalPrimitive(self):
+        # Primitive functional interfaces pass arguments without boxing
+        IntStream = JClass("java.util.stream.IntStream")
+        DoubleStream = JClass("java.util.stream.DoubleStream")
+        self.assertEqual(list(IntStream.range(0, 5).map(lambda x: 2 * x).toArray()), [0, 2, 4, 6, 8])
+        self.assertEqual(IntStream.range(0, 10).filter(lambda x: x % 2 == 0).count(), 5)
+        self.assertEqual(DoubleStream.of(1., 2., 3.).reduce(0., lambda a, b: a + b), 6.0)
+        self.assertEqual(list(IntStream.range(0, 3).mapToObj(lambda x: str(x)).toArray()), ["0", "1", "2"])
+
+    def testFunctionalPrimitiveObject(self):
+        f = JObject(lambda s: len(s), "java.util.function.ToLongFunction")
+        self.assertEqual(f.applyAsLong("abc"), 3)
+        f = JObject(lambda: True, "java.util.function.BooleanSupplier")
+        self.assertTrue(f.getAsBoolean())
+
+    def testFunctionalPrimitiveMethods(self):
+        @JImplements("java.util.function.IntPredicate")
+        class Even(object):
+            @JOverride
+            def test(self, x):
+                return x % 2 == 0
+
+            @JOverride
+            def toString(self):
+                return "even"
+
+        s = JObject(Even())
+        self.assertTrue(s.test(2))
+        self.assertEqual(s.toString(), "even")
+        self.assertTrue(s.equals(s))
+        self.assertIsInstance(s.hashCode(), int)
+
+    def testFunctionalPrimitiveRaise(self):
+        def bad(x):
+            raise ValueError("bad")
+        f = JObject(bad, "java.util.function.IntUnaryOperator")
+        with self.assertRaises(ValueError):
+            f.applyAsInt(1)
+
+    def testAsynchronous(self):
+        event = threading.Event()
+        values = []
+
+        @JImplements("jpype.proxy.TestAsync", asynchronous=True)
+        class MyAsync(object):
+            @JOverride
+            def notifyValue(self, value):
+                values.append(value)
+                event.set()
+
+            @JOverride
+            def compute(self, value):
+                if value < 0:
+                    raise ValueError("negative")
+                return value * 2
+
+            @JOverride
+            def direct(self, value):
+                return value + 1
+
+        proxy = JObject(MyAsync(), "jpype.proxy.TestAsync")
+        proxy.notifyValue("hello")
+        self.assertTrue(event.wait(10))
+        self.assertEqual(values, ["hello"])
+        future = proxy.compute(21)
+        self.assertEqual(future.get(), 42)
+        with self.assertRaises(JClass("java.util.concurrent.ExecutionException")):
+            proxy.compute(-1).get()
+        self.assertEqual(proxy.direct(1), 2)
+
+    def testAsynchronousJProxy(self):
+        event = threading.Event()
+        proxy = JObject(JProxy("java.util.function.IntConsumer",
+                               dict={'accept': lambda v: event.set()},
+                               asynchronous=True), "java.util.function.IntConsumer")
+        proxy.accept(1)
+        self.assertTrue(event.wait(10))
+
+    def testBatch(self):
+        event = threading.Event()
+        batches = []
+
+        @JImplements("jpype.proxy.TestAsync", batchSize=10, batchLatency=1.0)
+        class MyBatch(object):
+            @JOverride
+            def notifyValue(self, calls):
+                batches.append([args[0] for args in calls])
+                if sum(len(i) for i in batches) == 25:
+                    event.set()
+
+            @JOverride
+            def compute(self, value):
+                return None
+
+            @JOverride
+            def direct(self, value):
+                return value + 1
+
+        proxy = JObject(MyBatch(), "jpype.proxy.TestAsync")
+        for i in range(25):
+            proxy.notifyValue(JInt(i))
+        # Full batches are delivered by the caller
+        self.assertEqual(len(batches), 2)
+        self.assertTrue(event.wait(10))
+        self.assertEqual([len(i) for i in batches], [10, 10, 5])
+        self.assertEqual(sum(batches, []), list(range(25)))
+        # Methods with a return are not batched
+        self.assertEqual(proxy.direct(1), 2)
+
+    def checkBatchThreads(self, **kwargs):
+        event = threading.Event()
+        batches = []
+        threads = 4
+        count = 1000
+
+        @JImplements("jpype.proxy.TestAsync", batchSize=10, batchLatency=0.01, **kwargs)
+        class MyBatch(object):
+            @JOverride
+            def notifyValue(self, calls):
+                batches.append([int(args[0]) for args in calls])
+                if sum(len(i) for i in batches) == threads * count:
+                    event.set()
+
+            @JOverride
+            def compute(self, value):
+                return None
+
+            @JOverride
+            def direct(self, value):
+                return value + 1
+
+        proxy = JObject(MyBatch(), "jpype.proxy.TestAsync")
+        producer = JClass("jpype.proxy.AsyncProducer")
+        self.assertEqual(producer.produce(proxy, threads, count), 0)
+        self.assertTrue(event.wait(10))
+        values = sum(batches, [])
+        self.assertEqual(sorted(values), list(range(threads * count)))
+        # Each producer's calls arrive in the order they were made
+        for t in range(threads):
+            mine = [i for i in values if i // count == t]
+            self.assertEqual(mine, list(range(t * count, (t + 1) * count)))
+
+    def testBatchThreads(self):
+        self.checkBatchThreads()
+
+    def testBatchThreadsAsynchronous(self):
+        self.checkBatchThreads(asynchronous=True)
+
+
 @subrun.TestCase(individual=True)
 class TestProxyDefinitionWithoutJVM(common.JPypeTestCase):
     def setUp(self):
@@ -548,3 +709,55 @@ class TestProxyDefinitionWithoutJVM(common.JPypeTestCase):
 
         startJVM()
         assert isinstance(MyImpl(), MyImpl)
+
+
+@subrun.TestCase(individual=True)
+class TestProxyGenerated(common.JPypeTestCase):
+    def setUp(self):
+        # Start the JVM with generated proxies enabled
+        root = os.path.dirname(os.path.abspath(os.path.dirname(__file__)))
+        addClassPath(os.path.join(root, 'classes'))
+        startJVM("-Dorg.jpype.proxy.generate=true", convertStrings=False)
+        self.package = JPackage("jpype.proxy")
+
+    def testGeneratedCall(self):
+        c = C()
+        itf2 = self.package.TestInterface2
+        proxy = JObject(JProxy(itf2, inst=c), itf2)
+        self.assertIn("$JPypeProxy$", proxy.getClass().getName())
+        self.assertEqual(proxy.testMethod2(), 42)
+        result = self.package.ProxyTriggers().testCallbackWithParameters(proxy)
+        self.assertEqual(len(result), 3)
+        self.assertEqual(list(result[0]), [1, 2, 3, 4])
+        self.assertEqual(result[1], 12)
+        self.assertEqual(result[2], 13)
+
+    def testGeneratedClassReused(self):
+        itf2 = self.package.TestInterface2
+        p1 = JObject(JProxy(itf2, inst=C()), itf2)
+        p2 = JObject(JProxy(itf2, inst=C()), itf2)
+        self.assertEqual(p1.getClass(), p2.getClass())
+
+    def testGeneratedRoundTrip(self):
+        @JImplements(java.lang.Runnable)
+        class MyRun(object):
+            @JOverride
+            def run(self):
+                pass
+
+        al = JClass('java.util.ArrayList')()
+        runner = MyRun()
+        al.add(runner)
+        self.assertIs(al.get(0), runner)
+
+    def testGeneratedObjectMethods(self):
+        @JImplements(java.lang.Runnable)
+        class MyRun(object):
+            @JOverride
+            def run(self):
+                pass
+
+        proxy = JObject(MyRun(), java.lang.Runnable)
+        self.assertTrue(self.package.ProxyTriggers().testEquals(proxy))
+        self.assertEqual(proxy.hashCode(), proxy.hashCode())
+        self.assertIsNotNone(proxy.toString())
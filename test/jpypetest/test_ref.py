@@ -16,6 +16,10 @@
 #
 # *****************************************************************************
 import sys
+import gc
+import threading
+import time
+import weakref
 import _jpype
 import jpype
 from jpype import JImplements, JOverride
@@ -65,3 +69,60 @@ class ReferenceQueueTestCase(common.JPypeTestCase):
 
         # We can't check the results here as the GC may chose not
         # to run which would trigger a failure
+
+    def testBatch(self):
+        # References are staged and sent to Java in batches
+        start = self.refqueue.getQueueSize()
+        buffers = [_jpype.convertToDirectBuffer(bytearray(4)) for i in range(300)]
+        # A collection forces any staged references to be delivered
+        gc.collect()
+        self.assertGreaterEqual(self.refqueue.getQueueSize(), start + 300)
+        del buffers
+
+    def testThreads(self):
+        # Registration from many threads uses separate stripes
+        start = self.refqueue.getQueueSize()
+        held = []
+
+        def register():
+            held.extend(_jpype.convertToDirectBuffer(bytearray(4)) for i in range(100))
+        threads = [threading.Thread(target=register) for i in range(4)]
+        for t in threads:
+            t.start()
+        for t in threads:
+            t.join()
+        gc.collect()
+        self.assertGreaterEqual(self.refqueue.getQueueSize(), start + 400)
+        del held
+
+    def testProxyBatchRelease(self):
+        # Proxies freed together are released to Python in batches
+        @JImplements("java.lang.Runnable")
+        class MyRun(object):
+            @JOverride
+            def run(self):
+                pass
+
+        # More than two batches of JPypeReferenceQueue.BATCH_SIZE
+        count = 2 * 1024 + 10
+        al = JClass("java.util.ArrayList")()
+        refs = []
+        for i in range(count):
+            runner = MyRun()
+            al.add(runner)
+            refs.append(weakref.ref(runner))
+        del runner
+        gc.collect()
+        self.assertEqual(sum(1 for r in refs if r() is not None), count)
+
+        # Drop the Java side and wait for the queue to release the hosts
+        al.clear()
+        del al
+        System = JClass("java.lang.System")
+        for i in range(100):
+            gc.collect()
+            System.gc()
+            if all(r() is None for r in refs):
+                break
+            time.sleep(0.1)
+        self.assertEqual(sum(1 for r in refs if r() is not None), 0)
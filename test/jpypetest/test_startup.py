@@ -105,3 +105,71 @@ class StartJVMCase(unittest.TestCase):
     def testBadKeyword(self):
         with self.assertRaises(TypeError):
             jpype.startJVM(invalid=True)
+
+    def testClassSnapshot(self):
+        import tempfile
+        path = os.path.join(tempfile.mkdtemp(), 'jpype.snapshot')
+        # A damaged snapshot must be ignored and replaced
+        with open(path, 'wb') as fd:
+            fd.write(b'garbage')
+        runStartJVMTest(classpath=cp, classSnapshot=path,
+                        convertStrings=False)
+        String = jpype.JClass('java.lang.String')
+        self.assertEqual(String("abc").substring(1), "bc")
+        self.assertEqual(String.valueOf(1), "1")
+        jpype.shutdownJVM()
+        with open(path, 'rb') as fd:
+            self.assertEqual(fd.read(19)[2:], b'JPypeTypeSnapshot')
+
+    def testClassSnapshotRestore(self):
+        import subprocess
+        import tempfile
+        path = os.path.join(tempfile.mkdtemp(), 'jpype.snapshot')
+        # Write the snapshot from a separate process as the JVM can't restart
+        script = "\n".join([
+            "import jpype",
+            "jpype.startJVM(classpath=%r, classSnapshot=%r, convertStrings=False)" % (cp, path),
+            "String = jpype.JClass('java.lang.String')",
+            "String('abc').substring(1)",
+            "String.valueOf(1)",
+            "jpype.shutdownJVM()",
+        ])
+        subprocess.check_call([sys.executable, "-c", script])
+        self.assertTrue(os.path.exists(path))
+        runStartJVMTest(classpath=cp, classSnapshot=path,
+                        convertStrings=False)
+        String = jpype.JClass('java.lang.String')
+        self.assertEqual(String("abc").substring(1), "bc")
+        self.assertEqual(String.valueOf(1), "1")
+        context = jpype.JClass('org.jpype.JPypeContext').getInstance()
+        self.assertGreater(context.getTypeManager().snapshot.getRestored(), 0)
+
+    def testPackageIndex(self):
+        import tempfile
+        path = os.path.join(tempfile.mkdtemp(), 'jpype.index')
+        jar = os.path.join(root, 'jar', 'mrjar.jar')
+        runStartJVMTest(classpath=[cp, jar], packageIndex=path,
+                        convertStrings=False)
+        mrjar = jpype.JPackage("org.jpype.mrjar")
+        self.assertIn("A", dir(mrjar))
+        self.assertIn("sub", dir(mrjar))
+        self.assertTrue(jpype.JPackage("org.jpype.mrjar.sub").C)
+        self.assertTrue(os.path.exists(path))
+        with open(path, 'rb') as fd:
+            self.assertEqual(fd.read(19)[2:], b'JPypePackageIndex')
+
+    def testClassDataArchive(self):
+        import tempfile
+        from jpype._core import _javaVersion
+        path = os.path.join(tempfile.mkdtemp(), 'jpype.jsa')
+        # Archiving at exit requires Java 13
+        version = _javaVersion(jpype.getDefaultJVMPath())
+        if version is not None and version < 13:
+            with self.assertRaisesRegex(RuntimeError, "Java 13"):
+                runStartJVMTest(classpath=cp, classDataArchive=path,
+                                convertStrings=False)
+            return
+        runStartJVMTest(classpath=cp, classDataArchive=path,
+                        ignoreUnrecognized=True, convertStrings=False)
+        classpath = jpype.java.lang.System.getProperty('java.class.path')
+        self.assertIn('org.jpype.jar', str(classpath))
@@ -96,3 +96,27 @@ class SynchronizedTestCase(common.JPypeTestCase):
         with self.assertRaisesRegex(TypeError, "Java primitives cannot be used"):
             with jpype.synchronized(jpype.JInt(1)):
                 pass
+
+    def testSynchronizedReentrant(self):
+        Thread = jpype.JClass("java.lang.Thread")
+        self.assertFalse(Thread.holdsLock(obj))
+        with synchronized(obj):
+            self.assertTrue(Thread.holdsLock(obj))
+            with synchronized(obj):
+                with synchronized(obj):
+                    self.assertTrue(Thread.holdsLock(obj))
+            self.assertTrue(Thread.holdsLock(obj))
+        self.assertFalse(Thread.holdsLock(obj))
+
+    def testSynchronizedReentrantSame(self):
+        Thread = jpype.JClass("java.lang.Thread")
+        monitor = synchronized(obj)
+        with monitor:
+            with monitor:
+                self.assertTrue(Thread.holdsLock(obj))
+            self.assertTrue(Thread.holdsLock(obj))
+        self.assertFalse(Thread.holdsLock(obj))
+        # Leaving the monitor forgets it so the next entry waits again
+        with monitor:
+            self.assertTrue(Thread.holdsLock(obj))
+        self.assertFalse(Thread.holdsLock(obj))
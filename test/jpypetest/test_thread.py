@@ -67,3 +67,84 @@ class ThreadTestCase(common.JPypeTestCase):
         java.lang.Thread.attachAsDaemon()
         self.assertTrue(java.lang.Thread.isAttached())
         self.assertTrue(java.lang.Thread.currentThread().isDaemon())
+
+    def testDetachInThread(self):
+        import threading
+        results = []
+
+        def run():
+            # Calls after a detach must reattach rather than reuse the old env
+            for i in range(3):
+                s = jpype.JString("foo%d" % i)
+                results.append(str(s))
+                jpype.detachThreadFromJVM()
+                results.append(jpype.isThreadAttachedToJVM())
+
+        threads = [threading.Thread(target=run) for i in range(4)]
+        for t in threads:
+            t.start()
+        for t in threads:
+            t.join()
+        self.assertEqual(results.count(False), 12)
+        self.assertEqual(results.count("foo2"), 4)
+
+    def testAutoDetach(self):
+        import threading
+        import java
+        start = java.lang.Thread.getAttachStats()
+        java.lang.Thread.setAutoDetach(True)
+        try:
+            def run():
+                jpype.JString("foo")
+            threads = [threading.Thread(target=run) for i in range(4)]
+            for t in threads:
+                t.start()
+            for t in threads:
+                t.join()
+            # The detach happens as the native thread exits which may be
+            # slightly after join returns.
+            for i in range(100):
+                stats = java.lang.Thread.getAttachStats()
+                if stats['autoDetached'] - start['autoDetached'] >= 4:
+                    break
+                time.sleep(0.05)
+        finally:
+            java.lang.Thread.setAutoDetach(False)
+        self.assertEqual(stats['attached'] - start['attached'], 4)
+        self.assertEqual(stats['autoDetached'] - start['autoDetached'], 4)
+
+    def testAttachAlreadyAttached(self):
+        import java
+        start = java.lang.Thread.getAttachStats()
+        # The main thread is already attached so it is not counted
+        jpype.attachThreadToJVM()
+        stats = java.lang.Thread.getAttachStats()
+        self.assertEqual(stats['attached'], start['attached'])
+
+    def testAttachPoolBusy(self):
+        import concurrent.futures
+        import threading
+        import java
+        release = threading.Event()
+        with concurrent.futures.ThreadPoolExecutor(max_workers=2) as executor:
+            busy = executor.submit(release.wait)
+            # One worker is busy and more workers are requested than exist
+            count = java.lang.Thread.attachPool(executor, 4, timeout=0.2)
+            release.set()
+            busy.result()
+            self.assertLessEqual(count, 2)
+            for f in [executor.submit(java.lang.Thread.detach) for i in range(2)]:
+                f.result()
+
+    def testAttachPool(self):
+        import concurrent.futures
+        import java
+        start = java.lang.Thread.getAttachStats()
+        with concurrent.futures.ThreadPoolExecutor(max_workers=3) as executor:
+            self.assertEqual(java.lang.Thread.attachPool(executor, 3), 3)
+            stats = java.lang.Thread.getAttachStats()
+            self.assertEqual(stats['attached'] - start['attached'], 3)
+            attached = [executor.submit(jpype.isThreadAttachedToJVM) for i in range(6)]
+            self.assertTrue(all(f.result() for f in attached))
+            for f in [executor.submit(java.lang.Thread.detach) for i in range(3)]:
+                f.result()